@@ -0,0 +1,239 @@
+#include <list>
+#include <queue>
+
+#include "benchmarks.h"
+
+namespace {
+const std::size_t kQueueDepth = 1000;
+const std::size_t kQueueRounds = 1000000;
+
+// A queue kept at a steady depth: every round pushes one item and pops one.
+template <typename Queue>
+void queue_churn(const char *name) {
+  std::size_t before = bench::allocations;
+  double ns = bench::run_ns([] {
+    Queue q;
+    for (std::size_t i = 0; i < kQueueDepth; i++) {
+      q.push(static_cast<int>(i));
+    }
+    long sum = 0;
+    for (std::size_t i = 0; i < kQueueRounds; i++) {
+      sum += q.front();
+      q.pop();
+      q.push(static_cast<int>(i));
+    }
+    bench::keep(sum);
+  });
+  bench::report(name, ns, kQueueRounds);
+  bench::report_allocations(name, bench::allocations - before);
+}
+
+void queue_steady_state() {
+  queue_churn<std::queue<int, std::list<int>>>("std::queue<int, std::list>");
+  queue_churn<s21::queue<int>>("s21::queue<int>");
+}
+
+const std::size_t kListSize = 1000000;
+
+// Push/pop throughput at both ends around a list that starts empty: the
+// empty and single-element cases recur on every round.
+template <typename List>
+void push_pop(const char *name) {
+  List l;
+  double ns = bench::run_ns([&] {
+    long sum = 0;
+    for (std::size_t i = 0; i < kQueueRounds; i++) {
+      l.push_back(static_cast<int>(i));
+      l.push_front(static_cast<int>(i));
+      sum += l.back();
+      l.pop_back();
+      l.pop_front();
+    }
+    bench::keep(sum);
+  });
+  bench::report(name, ns, 4 * kQueueRounds);
+}
+
+void push_pops() {
+  push_pop<std::list<int>>("std::list push/pop both ends");
+  push_pop<s21::list<int>>("s21::list push/pop both ends");
+}
+
+template <typename List>
+void build_and_scan(const char *name, const char *scan_name) {
+  std::size_t before = bench::allocations;
+  List l;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kListSize; i++) {
+      l.push_back(static_cast<int>(i));
+    }
+  });
+  bench::report(name, ns, kListSize);
+  bench::report_allocations(name, bench::allocations - before);
+  ns = bench::run_ns([&] {
+    long sum = 0;
+    for (auto it = l.begin(); it != l.end(); ++it) {
+      sum += *it;
+    }
+    bench::keep(sum);
+  });
+  bench::report(scan_name, ns, kListSize);
+}
+
+void build_and_traverse() {
+  build_and_scan<std::list<int>>("std::list push_back", "std::list traverse");
+  build_and_scan<s21::list<int>>("s21::list push_back", "s21::list traverse");
+  build_and_scan<s21::unrolled_list<int>>("s21::unrolled_list push_back",
+                                          "s21::unrolled_list traverse");
+  build_and_scan<s21::vector<int>>("s21::vector push_back",
+                                   "s21::vector traverse");
+}
+
+const std::size_t kInsertSize = 100000;
+
+// Inserting a new element before every 8th one of a 100k-element sequence
+// while walking it, then scanning the result.
+template <typename Sequence>
+void insert_while_iterating(const char *name, const char *scan_name) {
+  Sequence seq;
+  for (std::size_t i = 0; i < kInsertSize; i++) {
+    seq.push_back(static_cast<int>(i));
+  }
+  double ns = bench::run_ns([&] {
+    for (auto it = seq.begin(); it != seq.end(); ++it) {
+      if (*it % 8 == 0) {
+        it = seq.insert(it, -*it);
+        ++it;
+      }
+    }
+  });
+  bench::report(name, ns, kInsertSize / 8);
+  ns = bench::run_ns([&] {
+    long sum = 0;
+    for (auto it = seq.begin(); it != seq.end(); ++it) {
+      sum += *it;
+    }
+    bench::keep(sum);
+  });
+  bench::report(scan_name, ns, kInsertSize + kInsertSize / 8);
+}
+
+void middle_inserts() {
+  insert_while_iterating<s21::list<int>>("s21::list insert while iterating",
+                                         "s21::list traverse after");
+  insert_while_iterating<s21::unrolled_list<int>>(
+      "s21::unrolled_list insert while iterating",
+      "s21::unrolled_list traverse after");
+  insert_while_iterating<s21::vector<int>>(
+      "s21::vector insert while iterating", "s21::vector traverse after");
+}
+
+// Dropping every third element of a 1M-element list while walking it.
+template <typename List>
+void erase_while_iterating(const char *name) {
+  List l;
+  for (std::size_t i = 0; i < kListSize; i++) {
+    l.push_back(static_cast<int>(i));
+  }
+  double ns = bench::run_ns([&] {
+    for (auto it = l.begin(); it != l.end();) {
+      if (*it % 3 == 0) {
+        it = l.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  });
+  bench::report(name, ns, kListSize);
+  bench::keep(l);
+}
+
+void erases() {
+  erase_while_iterating<std::list<int>>("std::list erase while iterating (1M)");
+  erase_while_iterating<s21::list<int>>("s21::list erase while iterating (1M)");
+}
+
+// Merging two sorted 500k-element lists, evens into odds.
+template <typename List>
+void merge_sorted(const char *name) {
+  List evens;
+  List odds;
+  for (std::size_t i = 0; i < kListSize / 2; i++) {
+    evens.push_back(static_cast<int>(2 * i));
+    odds.push_back(static_cast<int>(2 * i + 1));
+  }
+  double ns = bench::run_ns([&] { odds.merge(evens); });
+  bench::report(name, ns, kListSize);
+  bench::keep(odds);
+}
+
+// Handing a batch of 1000 work items back and forth between two queues,
+// whole batches at a time and one item at a time.
+template <typename List>
+void hand_off(const char *batch_name, const char *item_name) {
+  List mine;
+  List theirs;
+  for (std::size_t i = 0; i < kQueueDepth; i++) {
+    mine.push_back(static_cast<int>(i));
+  }
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kQueueRounds / 2; i++) {
+      theirs.splice(theirs.end(), mine);
+      mine.splice(mine.end(), theirs);
+    }
+  });
+  bench::report(batch_name, ns, kQueueRounds);
+  ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kQueueRounds; i++) {
+      theirs.splice(theirs.end(), mine, mine.begin());
+      if (mine.empty()) {
+        mine.swap(theirs);
+      }
+    }
+  });
+  bench::report(item_name, ns, kQueueRounds);
+  bench::keep(mine);
+}
+
+void merges_and_splices() {
+  merge_sorted<std::list<int>>("std::list merge (2 x 500k)");
+  merge_sorted<s21::list<int>>("s21::list merge (2 x 500k)");
+  hand_off<std::list<int>>("std::list splice whole batch",
+                           "std::list splice one item");
+  hand_off<s21::list<int>>("s21::list splice whole batch",
+                           "s21::list splice one item");
+}
+
+const std::size_t kSortSize = 100000;
+
+// Sorting 100k scattered ints, then sorting the already sorted result.
+template <typename List>
+void sort_list(const char *name, const char *sorted_name) {
+  List l;
+  for (std::size_t i = 0; i < kSortSize; i++) {
+    l.push_back(static_cast<int>((i * 7919) % kSortSize));
+  }
+  double ns = bench::run_ns([&] { l.sort(); });
+  bench::report(name, ns, kSortSize);
+  ns = bench::run_ns([&] { l.sort(); });
+  bench::report(sorted_name, ns, kSortSize);
+  bench::keep(l);
+}
+
+void sorts() {
+  sort_list<std::list<int>>("std::list sort (100k)",
+                            "std::list sort sorted (100k)");
+  sort_list<s21::list<int>>("s21::list sort (100k)",
+                            "s21::list sort sorted (100k)");
+}
+}  // namespace
+
+void list_benchmarks() {
+  queue_steady_state();
+  push_pops();
+  build_and_traverse();
+  middle_inserts();
+  erases();
+  merges_and_splices();
+  sorts();
+}
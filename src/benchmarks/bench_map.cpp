@@ -0,0 +1,419 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "benchmarks.h"
+
+namespace {
+const std::size_t kMapSize = 100000;
+
+// Keys in a scattered but reproducible order.
+int key_at(std::size_t i) { return static_cast<int>((i * 7919) % kMapSize); }
+
+template <typename Map>
+void build_copy_clear(const char *build_name, const char *copy_name,
+                      const char *clear_name) {
+  std::size_t before = bench::allocations;
+  Map m;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kMapSize; i++) {
+      m.insert({key_at(i), static_cast<int>(i)});
+    }
+  });
+  bench::report(build_name, ns, kMapSize);
+  bench::report_allocations(build_name, bench::allocations - before);
+
+  before = bench::allocations;
+  ns = bench::run_ns([&] {
+    Map copy(m);
+    bench::keep(copy);
+  });
+  bench::report(copy_name, ns, kMapSize);
+  bench::report_allocations(copy_name, bench::allocations - before);
+
+  ns = bench::run_ns([&] { m.clear(); });
+  bench::report(clear_name, ns, kMapSize);
+}
+
+void lookup_map_lifecycle() {
+  build_copy_clear<std::map<int, int>>("std::map insert", "std::map copy",
+                                       "std::map clear");
+  build_copy_clear<s21::map<int, int>>("s21::map insert", "s21::map copy",
+                                       "s21::map clear");
+}
+const std::size_t kLargeMapSize = 1000000;
+
+// size() in a loop condition, the way logging and batching code uses it.
+template <typename Map>
+void size_in_loop(const char *name) {
+  Map m;
+  for (std::size_t i = 0; i < kLargeMapSize; i++) {
+    m.insert({static_cast<int>(i), static_cast<int>(i)});
+  }
+  std::size_t calls = 0;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < m.size(); i++) {
+      calls++;
+      bench::keep(calls);
+    }
+  });
+  bench::report(name, ns, calls);
+}
+
+// Inserts into a map too large for the cache, where each extra walk from
+// the root is a chain of misses.
+template <typename Map>
+void insert_large(const char *name) {
+  Map m;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kLargeMapSize; i++) {
+      int key = static_cast<int>((i * 7919) % kLargeMapSize);
+      m.insert({key, key});
+    }
+  });
+  bench::report(name, ns, kLargeMapSize);
+  bench::keep(m);
+}
+
+void size_queries() {
+  size_in_loop<std::map<int, int>>("std::map size() x1M (1M elements)");
+  size_in_loop<s21::map<int, int>>("s21::map size() x1M (1M elements)");
+}
+
+// Full in-order scan reading every value, with strings too long for the
+// small-string buffer so that a copy per element would allocate.
+template <typename Map>
+void scan(const char *name) {
+  Map m;
+  for (std::size_t i = 0; i < kMapSize; i++) {
+    m.insert({key_at(i), std::string(40, 'a' + i % 26)});
+  }
+  std::size_t before = bench::allocations;
+  std::size_t total = 0;
+  double ns = bench::run_ns([&] {
+    for (auto it = m.begin(); it != m.end(); ++it) {
+      total += (*it).second.size();
+    }
+  });
+  bench::keep(total);
+  bench::report(name, ns, kMapSize);
+  bench::report_allocations(name, bench::allocations - before);
+}
+
+// Scan where the per-step cost is the iterator itself.
+template <typename Map>
+void scan_ints(const char *name) {
+  Map m;
+  for (std::size_t i = 0; i < kLargeMapSize; i++) {
+    m.insert({static_cast<int>(i), static_cast<int>(i)});
+  }
+  long total = 0;
+  double ns = bench::run_ns([&] {
+    for (auto it = m.begin(); it != m.end(); ++it) {
+      total += (*it).second;
+    }
+  });
+  bench::keep(total);
+  bench::report(name, ns, kLargeMapSize);
+}
+
+void scans() {
+  scan<std::map<int, std::string>>("std::map scan (40-char strings)");
+  scan<s21::map<int, std::string>>("s21::map scan (40-char strings)");
+  scan_ints<std::map<int, int>>("std::map scan (1M ints)");
+  scan_ints<s21::map<int, int>>("s21::map scan (1M ints)");
+}
+
+// m[k]++ over a small key space, then overwriting every existing key.
+template <typename Map>
+void counters(const char *count_name, const char *assign_name) {
+  const std::size_t kOps = 1000000;
+  const std::size_t kKeys = 10000;
+  Map m;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kOps; i++) {
+      m[static_cast<int>((i * 7919) % kKeys)]++;
+    }
+  });
+  bench::report(count_name, ns, kOps);
+  ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kOps; i++) {
+      m.insert_or_assign(static_cast<int>((i * 7919) % kKeys),
+                         static_cast<int>(i));
+    }
+  });
+  bench::report(assign_name, ns, kOps);
+  bench::keep(m);
+}
+
+void updates() {
+  counters<std::map<int, int>>("std::map m[k]++ (10k keys)",
+                               "std::map insert_or_assign (10k keys)");
+  counters<s21::map<int, int>>("s21::map m[k]++ (10k keys)",
+                               "s21::map insert_or_assign (10k keys)");
+}
+
+// Reloading a snapshot: 1M entries already sorted by key, built either by
+// the range constructor or by inserting one at a time.
+template <typename Map>
+void bulk_build(const char *range_name, const char *loop_name) {
+  std::vector<std::pair<int, int>> items;
+  for (std::size_t i = 0; i < kLargeMapSize; i++) {
+    items.push_back({static_cast<int>(i), static_cast<int>(i)});
+  }
+  double ns = bench::run_ns([&] {
+    Map m(items.begin(), items.end());
+    bench::keep(m);
+  });
+  bench::report(range_name, ns, kLargeMapSize);
+  ns = bench::run_ns([&] {
+    Map m;
+    for (const auto &item : items) {
+      m.insert(item);
+    }
+    bench::keep(m);
+  });
+  bench::report(loop_name, ns, kLargeMapSize);
+}
+
+void bulk_builds() {
+  bulk_build<std::map<int, int>>("std::map range ctor (1M sorted)",
+                                 "std::map insert loop (1M sorted)");
+  bulk_build<s21::map<int, int>>("s21::map range ctor (1M sorted)",
+                                 "s21::map insert loop (1M sorted)");
+}
+
+// Merging two interleaved 100k-key maps; other is rebuilt each round.
+template <typename Map>
+void merge_maps(const char *name) {
+  double total_ns = 0;
+  const int kRounds = 5;
+  for (int round = 0; round < kRounds; round++) {
+    Map m;
+    Map other;
+    for (std::size_t i = 0; i < kMapSize; i++) {
+      m.insert({static_cast<int>(2 * i), 0});
+      other.insert({static_cast<int>(2 * i + 1), 0});
+    }
+    total_ns += bench::run_ns([&] { m.merge(other); });
+    bench::keep(m);
+  }
+  bench::report(name, total_ns / kRounds, 2 * kMapSize);
+}
+
+// Intersecting ID sets of 1M with 1M and 1M with 1k elements.
+template <typename Set, typename Intersect>
+void intersect_sets(const char *same_name, const char *skewed_name,
+                    Intersect intersect) {
+  Set large;
+  Set large2;
+  Set small;
+  for (std::size_t i = 0; i < kLargeMapSize; i++) {
+    large.insert(static_cast<int>(2 * i));
+    large2.insert(static_cast<int>(3 * i));
+  }
+  for (std::size_t i = 0; i < 1000; i++) {
+    small.insert(static_cast<int>(i * 997));
+  }
+  std::size_t found = 0;
+  double ns = bench::run_ns([&] { found += intersect(large, large2).size(); });
+  bench::report(same_name, ns, 2 * kLargeMapSize);
+  ns = bench::run_ns([&] { found += intersect(large, small).size(); });
+  bench::report(skewed_name, ns, 1000);
+  bench::keep(found);
+}
+
+void set_operations() {
+  merge_maps<std::map<int, int>>("std::map merge (2 x 100k)");
+  merge_maps<s21::map<int, int>>("s21::map merge (2 x 100k)");
+  intersect_sets<std::set<int>>(
+      "std::set_intersection (1M x 1M)", "std::set_intersection (1M x 1k)",
+      [](const std::set<int> &a, const std::set<int> &b) {
+        std::set<int> result;
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+                              std::inserter(result, result.end()));
+        return result;
+      });
+  intersect_sets<s21::set<int>>(
+      "s21::set_intersection (1M x 1M)", "s21::set_intersection (1M x 1k)",
+      [](const s21::set<int> &a, const s21::set<int> &b) {
+        return s21::set_intersection(a, b);
+      });
+}
+
+// Percentile lookups on a 1M-element set: element at position k.
+template <typename Set, typename Select>
+void percentile(const char *name, std::size_t queries, Select select) {
+  Set scores;
+  for (std::size_t i = 0; i < kLargeMapSize; i++) {
+    scores.insert(static_cast<int>((i * 7919) % kLargeMapSize));
+  }
+  // Spread the positions over the whole set however few queries there are.
+  std::size_t stride = 7919 * (kLargeMapSize / queries);
+  long long sum = 0;
+  double ns = bench::run_ns([&] {
+    for (std::size_t q = 0; q < queries; q++) {
+      sum += *select(scores, (q * stride) % kLargeMapSize);
+    }
+  });
+  bench::report(name, ns, queries);
+  bench::keep(sum);
+}
+
+void order_statistics() {
+  percentile<std::set<int>>("std::set std::next to k (1M)", 10,
+                            [](std::set<int> &s, std::size_t k) {
+                              return std::next(s.begin(), k);
+                            });
+  percentile<s21::set<int>>("s21::set nth(k) (1M)", 1000000,
+                            [](s21::set<int> &s, std::size_t k) {
+                              return s.nth(k);
+                            });
+}
+
+// Summing 64-key time windows of a 1M-key map; window(m, lo, hi) adds up
+// the values with keys in [lo, hi).
+template <typename Map, typename Window>
+void time_windows(const char *name, std::size_t queries, Window window) {
+  Map events;
+  for (std::size_t i = 0; i < kLargeMapSize; i++) {
+    events.insert({static_cast<long>(i * 10), static_cast<int>(i)});
+  }
+  std::size_t stride = 7919 * (kLargeMapSize / queries);
+  long long sum = 0;
+  double ns = bench::run_ns([&] {
+    for (std::size_t q = 0; q < queries; q++) {
+      long lo = static_cast<long>((q * stride) % kLargeMapSize) * 10;
+      sum += window(events, lo, lo + 640);
+    }
+  });
+  bench::report(name, ns, queries);
+  bench::keep(sum);
+}
+
+void range_queries() {
+  time_windows<std::map<long, int>>(
+      "std::map lower_bound window (1M)", 100000,
+      [](std::map<long, int> &m, long lo, long hi) {
+        long long sum = 0;
+        for (auto it = m.lower_bound(lo); it != m.end() && it->first < hi;
+             ++it) {
+          sum += it->second;
+        }
+        return sum;
+      });
+  time_windows<s21::map<long, int>>(
+      "s21::map scan-from-begin window (1M)", 10,
+      [](s21::map<long, int> &m, long lo, long hi) {
+        long long sum = 0;
+        for (auto it = m.begin(); it != m.end(); ++it) {
+          if (it->first >= hi) break;
+          if (it->first >= lo) sum += it->second;
+        }
+        return sum;
+      });
+  time_windows<s21::map<long, int>>(
+      "s21::map range window (1M)", 100000,
+      [](s21::map<long, int> &m, long lo, long hi) {
+        long long sum = 0;
+        for (auto &event : m.range(lo, hi)) {
+          sum += event.second;
+        }
+        return sum;
+      });
+}
+
+// Lookups of 100k string keys that arrive as string_views, the way a parser
+// or a network buffer hands them out. Keys are longer than the small-string
+// buffer, so a std::string built for the lookup allocates.
+std::string session_key(std::size_t i) {
+  return "session:" + std::to_string(key_at(i)) + ":payload";
+}
+
+template <typename Map, typename Find>
+void string_lookup(const char *name, Find find) {
+  Map m;
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < kMapSize; i++) {
+    keys.push_back(session_key(i));
+    m.insert({keys.back(), static_cast<int>(i)});
+  }
+  std::reverse(keys.begin(), keys.end());
+  std::vector<std::string_view> views(keys.begin(), keys.end());
+  std::size_t before = bench::allocations;
+  long long sum = 0;
+  double ns = bench::run_ns([&] {
+    for (std::string_view view : views) {
+      sum += find(m, view);
+    }
+  });
+  bench::report(name, ns, kMapSize);
+  bench::report_allocations(name, bench::allocations - before);
+  bench::keep(sum);
+}
+
+void string_lookups() {
+  using less_map = s21::map<std::string, int>;
+  using transparent_map = s21::map<std::string, int, std::less<>>;
+  string_lookup<less_map>("s21::map find(std::string(view))",
+                          [](less_map &m, std::string_view key) {
+                            return m.find(std::string(key))->second;
+                          });
+  string_lookup<transparent_map>("s21::map<.., std::less<>> find(view)",
+                                 [](transparent_map &m, std::string_view key) {
+                                   return m.find(key)->second;
+                                 });
+}
+
+void large_inserts() {
+  insert_large<std::map<int, int>>("std::map insert (1M keys)");
+  insert_large<s21::map<int, int>>("s21::map insert (1M keys)");
+}
+
+// A value large enough that moving it between nodes costs more than
+// relinking the nodes themselves.
+struct Payload {
+  char bytes[256];
+};
+
+template <typename Map>
+void insert_erase_large(const char *name) {
+  Map m;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kMapSize; i++) {
+      m.insert({key_at(i), Payload{}});
+    }
+    for (std::size_t i = 0; i < kMapSize; i += 2) {
+      m.erase(m.find(key_at(i)));
+    }
+  });
+  bench::report(name, ns, kMapSize + kMapSize / 2);
+  bench::keep(m);
+}
+
+void large_values() {
+  insert_erase_large<std::map<int, Payload>>(
+      "std::map insert+erase (256B values)");
+  insert_erase_large<s21::map<int, Payload>>(
+      "s21::map insert+erase (256B values)");
+}
+}  // namespace
+
+void map_benchmarks() {
+  lookup_map_lifecycle();
+  size_queries();
+  large_inserts();
+  large_values();
+  scans();
+  updates();
+  bulk_builds();
+  set_operations();
+  order_statistics();
+  range_queries();
+  string_lookups();
+}
@@ -0,0 +1,200 @@
+#include <string>
+
+#include "benchmarks.h"
+
+namespace {
+const std::size_t kPushCount = 1000000;
+
+template <typename Vector>
+double push_back_ns(Vector v) {
+  return bench::run_ns([&] {
+    for (std::size_t i = 0; i < kPushCount; i++) {
+      v.push_back(static_cast<int>(i));
+    }
+    bench::keep(v);
+  });
+}
+
+template <typename Growth>
+using growth_vector = s21::vector<int, std::allocator<int>, Growth>;
+
+void push_back_growth() {
+  auto triple = [](std::size_t capacity, std::size_t required) {
+    return capacity * 3 > required ? capacity * 3 : required;
+  };
+
+  bench::report("std::vector push_back", push_back_ns(std::vector<int>()),
+                kPushCount);
+  bench::report("s21::vector push_back (2x)", push_back_ns(s21::vector<int>()),
+                kPushCount);
+  bench::report("s21::vector push_back (1.5x)",
+                push_back_ns(growth_vector<s21::geometric_growth<3, 2>>()),
+                kPushCount);
+  bench::report("s21::vector push_back (+4096)",
+                push_back_ns(growth_vector<s21::fixed_growth<4096>>()),
+                kPushCount);
+  bench::report("s21::vector push_back (callable 3x)",
+                push_back_ns(growth_vector<decltype(triple)>(triple)),
+                kPushCount);
+}
+const std::size_t kStringCount = 100000;
+
+// Strings longer than the small-string buffer, so every copy allocates.
+template <typename Vector>
+void push_back_strings(const char *name) {
+  const std::string value(32, 'x');
+  std::size_t before = bench::allocations;
+  double ns = bench::run_ns([&] {
+    Vector v;
+    for (std::size_t i = 0; i < kStringCount; i++) {
+      v.push_back(value);
+    }
+    bench::keep(v);
+  });
+  bench::report(name, ns, kStringCount);
+  bench::report_allocations(name, bench::allocations - before);
+}
+
+void string_storage() {
+  push_back_strings<std::vector<std::string>>("std::vector<string> push_back");
+  push_back_strings<s21::vector<std::string>>("s21::vector<string> push_back");
+}
+const std::size_t kMiddleSize = 1000000;
+const std::size_t kMiddleRounds = 100;
+
+// Eight values into the middle of a 1M-element vector, kMiddleRounds times.
+void insert_middle() {
+  std::vector<int> std_vector(kMiddleSize);
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kMiddleRounds; i++) {
+      std_vector.insert(std_vector.begin() + std_vector.size() / 2,
+                        {1, 2, 3, 4, 5, 6, 7, 8});
+    }
+    bench::keep(std_vector);
+  });
+  bench::report("std::vector insert 8 (range)", ns, kMiddleRounds);
+
+  s21::vector<int> one_by_one(kMiddleSize);
+  ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kMiddleRounds; i++) {
+      for (int v = 8; v > 0; v--) {
+        one_by_one.insert(one_by_one.begin() + one_by_one.size() / 2, v);
+      }
+    }
+    bench::keep(one_by_one);
+  });
+  bench::report("s21::vector insert 8 (one by one)", ns, kMiddleRounds);
+
+  s21::vector<int> many(kMiddleSize);
+  ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kMiddleRounds; i++) {
+      many.insert_many(many.begin() + many.size() / 2, 1, 2, 3, 4, 5, 6, 7, 8);
+    }
+    bench::keep(many);
+  });
+  bench::report("s21::vector insert_many 8", ns, kMiddleRounds);
+}
+const std::size_t kIndexSize = 1 << 16;
+const std::size_t kIndexRounds = 1000;
+
+template <typename Vector>
+double indexed_add_ns() {
+  Vector v(kIndexSize);
+  Vector w(kIndexSize);
+  for (std::size_t i = 0; i < kIndexSize; i++) {
+    w[i] = static_cast<float>(i);
+  }
+  return bench::run_ns([&] {
+    for (std::size_t round = 0; round < kIndexRounds; round++) {
+      for (std::size_t i = 0; i < kIndexSize; i++) {
+        v[i] += w[i];
+      }
+      bench::keep(v);
+    }
+  });
+}
+
+// v[i] += w[i]: vectorizes only when operator[] carries no bounds check.
+void indexed_access() {
+  std::size_t ops = kIndexSize * kIndexRounds;
+  bench::report("std::vector v[i] += w[i]",
+                indexed_add_ns<std::vector<float>>(), ops);
+  bench::report("s21::vector v[i] += w[i]",
+                indexed_add_ns<s21::vector<float>>(), ops);
+}
+const std::size_t kCompactSize = 200000;
+const std::size_t kCompactBatch = 5000;
+
+// Removes kCompactBatch items from the front half of a 200k-element vector.
+void erase_batch() {
+  const std::vector<std::string> source(kCompactSize, std::string(24, 's'));
+
+  std::vector<std::string> std_vector(source);
+  double ns = bench::run_ns([&] {
+    auto first = std_vector.begin() + kCompactSize / 4;
+    std_vector.erase(first, first + kCompactBatch);
+    bench::keep(std_vector);
+  });
+  bench::report("std::vector<string> erase(first, last)", ns, kCompactBatch);
+
+  s21::vector<std::string> one_by_one;
+  one_by_one.insert(one_by_one.end(), source.begin(), source.end());
+  ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kCompactBatch; i++) {
+      one_by_one.erase(one_by_one.begin() + kCompactSize / 4);
+    }
+    bench::keep(one_by_one);
+  });
+  bench::report("s21::vector<string> erase x5000", ns, kCompactBatch);
+
+  s21::vector<std::string> ranged;
+  ranged.insert(ranged.end(), source.begin(), source.end());
+  ns = bench::run_ns([&] {
+    auto first = ranged.begin() + kCompactSize / 4;
+    ranged.erase(first, first + kCompactBatch);
+    bench::keep(ranged);
+  });
+  bench::report("s21::vector<string> erase(first, last)", ns, kCompactBatch);
+
+  s21::vector<int> ints(kCompactSize);
+  ns = bench::run_ns([&] {
+    auto first = ints.begin() + kCompactSize / 4;
+    ints.erase(first, first + kCompactBatch);
+    bench::keep(ints);
+  });
+  bench::report("s21::vector<int> erase(first, last)", ns, kCompactBatch);
+}
+const std::size_t kTinyCount = 1000000;
+
+// A million short-lived collections of 8 ints, as in per-request scratch data.
+template <typename Vector>
+void tiny_vectors(const char *name) {
+  std::size_t before = bench::allocations;
+  double ns = bench::run_ns([&] {
+    for (std::size_t i = 0; i < kTinyCount; i++) {
+      Vector v;
+      for (int j = 0; j < 8; j++) {
+        v.push_back(j);
+      }
+      bench::keep(v);
+    }
+  });
+  bench::report(name, ns, kTinyCount);
+  bench::report_allocations(name, bench::allocations - before);
+}
+
+void small_collections() {
+  tiny_vectors<std::vector<int>>("std::vector<int> x8");
+  tiny_vectors<s21::vector<int>>("s21::vector<int> x8");
+  tiny_vectors<s21::small_vector<int, 16>>("s21::small_vector<int, 16> x8");
+}
+}  // namespace
+
+void vector_benchmarks() {
+  push_back_growth();
+  string_storage();
+  insert_middle();
+  indexed_access();
+  erase_batch();
+  small_collections();
+}
@@ -0,0 +1,47 @@
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "benchmarks.h"
+
+std::size_t bench::allocations = 0;
+
+void *operator new(std::size_t size) {
+  bench::allocations++;
+  if (void *p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+struct group {
+  const char *name;
+  void (*run)();
+};
+
+const group groups[] = {
+    {"vector", vector_benchmarks},
+    {"list", list_benchmarks},
+    {"map", map_benchmarks},
+};
+}  // namespace
+
+// Usage: ./bench [group...]; runs every group when none is given.
+int main(int argc, char **argv) {
+  for (const group &g : groups) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; i++) {
+      selected = selected || std::strcmp(argv[i], g.name) == 0;
+    }
+    if (selected) {
+      std::printf("[%s]\n", g.name);
+      g.run();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,45 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace bench {
+// Number of global operator new calls since program start.
+extern std::size_t allocations;
+
+// Keeps the optimizer from dropping the computation that produced value.
+template <typename T>
+inline void keep(T const &value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+// Runs body once and returns the wall time in nanoseconds.
+template <typename F>
+double run_ns(F &&body) {
+  auto start = std::chrono::steady_clock::now();
+  body();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+inline void report(const char *name, double ns, std::size_t ops) {
+  std::printf("  %-44s %12.2f ms %10.2f ns/op\n", name, ns / 1e6,
+              ops ? ns / static_cast<double>(ops) : 0.0);
+}
+
+inline void report_allocations(const char *name, std::size_t count) {
+  std::printf("  %-44s %12zu allocations\n", name, count);
+}
+}  // namespace bench
+
+void vector_benchmarks();
+void list_benchmarks();
+void map_benchmarks();
+
+#endif
@@ -47,8 +47,6 @@ class array {
   }
 
   array &operator=(array &&a) {
-    correct();
-    a.correct();
     if (this != &a) {
       size_ = a.size_;
       for (size_type i = 0; i < size_; i++) {
@@ -60,7 +58,6 @@ class array {
   }
 
   inline reference at(size_type pos) {
-    correct();
     if (pos >= size_) {
       throw std::out_of_range("Error: invalid index");
     }
@@ -76,12 +73,10 @@ class array {
   }
 
   inline const_reference front() {
-    correct();
     return data_[0];
   }
 
   inline const_reference back() {
-    correct();
     return data_[N - 1];
   }
 
@@ -103,7 +98,6 @@ class array {
   }
 
   void fill(const_reference value) {
-    correct();
     if (empty()) {
       throw std::logic_error("Error: Array is empty");
     }
@@ -115,12 +109,6 @@ class array {
  private:
   value_type data_[N];
   size_type size_;
-
-  inline void correct() {
-    if (size_ < 0) {
-      throw std::length_error("Error: empty array");
-    }
-  }
 };
 }  // namespace s21
 
@@ -2,27 +2,53 @@
 #ifndef S21_LIST_H
 #define S21_LIST_H
 
+#include <cassert>
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <limits>
 #include <stdexcept>
 #include <utility>
 
+#include "../s21_memory.h"
+
 namespace s21 {
+struct list_node_base {
+  list_node_base *next = nullptr;
+  list_node_base *prev = nullptr;
+};
+
 template <class T>
-class list {
+struct list_node : list_node_base {
+  T data;
+
+  template <typename... Args>
+  explicit list_node(Args &&...args) : data(std::forward<Args>(args)...) {}
+};
+
+// The list is a ring through a sentinel node kept in the list object: the
+// sentinel's next is the first element, its prev the last, and end() points
+// at it. Every element has real neighbours, so linking and unlinking never
+// branch on the ends, and end() stays valid and can be decremented.
+// Nodes come from a per-list node_pool whose slabs are allocated through
+// Allocator rebound to list_node<T>. Memory of erased nodes stays with the
+// list for reuse until shrink_to_fit() or destruction. Lists built on the
+// same shared_pool draw their nodes from it instead and can hand nodes to
+// each other.
+template <class T, class Allocator = std::allocator<T>>
+class list : private allocator_base<typename std::allocator_traits<
+                 Allocator>::template rebind_alloc<list_node<T>>> {
  public:
-  struct Node {
-    Node *next = nullptr;
-    Node *prev = nullptr;
-    T data;
+  using Node = list_node<T>;
+  using NodeBase = list_node_base;
 
-    Node(const T &data) noexcept : next(nullptr), prev(nullptr), data(data) {}
-  };
+ private:
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
 
  protected:
-  Node *m_head;
-  Node *m_tail;
+  NodeBase m_sentinel;
   size_t m_size;
 
  public:
@@ -31,11 +57,14 @@ class list {
   using const_reference = const T &;
   using pointer = T *;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
+  using shared_pool = shared_node_pool<Node, node_allocator>;
 
  public:
   class Const_List_Iterator {
    private:
-    explicit Const_List_Iterator(const Node *ptr) noexcept : m_current{ptr} {}
+    explicit Const_List_Iterator(const NodeBase *ptr) noexcept
+        : m_current{ptr} {}
 
     friend class list;
 
@@ -46,7 +75,7 @@ class list {
 
     reference operator*() const noexcept {
       assert(m_current != nullptr);
-      return m_current->data;
+      return static_cast<const Node *>(m_current)->data;
     }
 
     Const_List_Iterator &operator++() noexcept {
@@ -84,17 +113,18 @@ class list {
     bool operator!=(Const_List_Iterator other) const noexcept {
       return !(*this == other);
     }
-    const Node *getNodePtr() noexcept { return m_current; }
+    const NodeBase *getNodePtr() noexcept { return m_current; }
 
    protected:
-    const Node *m_current;
+    const NodeBase *m_current;
   };
 
   class List_Iterator : public Const_List_Iterator {
    private:
     friend class list;
 
-    explicit List_Iterator(Node *ptr) noexcept : Const_List_Iterator{ptr} {}
+    explicit List_Iterator(NodeBase *ptr) noexcept
+        : Const_List_Iterator{ptr} {}
 
    public:
     using value_type = list::value_type;
@@ -117,18 +147,18 @@ class list {
 
     List_Iterator operator++(int) noexcept {
       auto res = Const_List_Iterator::operator++(0);
-      return List_Iterator{const_cast<Node *>(res.getNodePtr())};
+      return List_Iterator{const_cast<NodeBase *>(res.getNodePtr())};
     }
 
     List_Iterator operator--(int) noexcept {
       auto res = Const_List_Iterator::operator--(0);
-      return List_Iterator{const_cast<Node *>(res.getNodePtr())};
+      return List_Iterator{const_cast<NodeBase *>(res.getNodePtr())};
     }
     bool operator==(List_Iterator other) noexcept {
       return Const_List_Iterator::operator==(other);
     }
-    Node *getNodePtr() noexcept {
-      return const_cast<Node *>(Const_List_Iterator::getNodePtr());
+    NodeBase *getNodePtr() noexcept {
+      return const_cast<NodeBase *>(Const_List_Iterator::getNodePtr());
     }
   };
 
@@ -138,13 +168,22 @@ class list {
 
  public:
   list() noexcept;
-  explicit list(size_type n);
-  list(std::initializer_list<value_type> const &items);
+  explicit list(const Allocator &alloc) noexcept;
+  // The list allocates from pool, which must outlive it. Copies of the list
+  // get their own pool; moving or swapping it carries pool along.
+  explicit list(shared_pool &pool) noexcept;
+  explicit list(size_type n, const Allocator &alloc = Allocator());
+  list(std::initializer_list<value_type> const &items,
+       const Allocator &alloc = Allocator());
   explicit list(const list &v);
+  list(const list &v, const Allocator &alloc);
   list(list &&other) noexcept;
   ~list();
   list &operator=(const list &other);
-  list &operator=(list &&other) noexcept;
+  list &operator=(list &&other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value);
+  allocator_type get_allocator() const;
   const_reference front();
   const_reference back();
   bool empty() const;
@@ -157,349 +196,605 @@ class list {
   void clear();
   iterator begin();
   iterator end();
-  void erase(iterator pos);
+  // erase and insert use the node behind the iterator and run in O(1).
+  // erase returns the element after the last one removed.
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
   void swap(list &other);
+  // Stable merge sort that relinks nodes and never copies or moves T;
+  // O(n log n) comparisons and O(1) extra memory.
   void sort();
+  template <typename Compare>
+  void sort(Compare comp);
+  // Merges the sorted other into this sorted list in one pass, relinking
+  // other's nodes; equivalent elements of *this come first. other ends up
+  // empty.
   void merge(list &other);
+  template <typename Compare>
+  void merge(list &other, Compare comp);
+  // Moving elements within one list, all of another list, or any of the
+  // elements of a list on the same shared_pool relinks nodes in O(1), or
+  // O(k) for k elements of another list. Otherwise each list allocates its
+  // nodes from its own pool, so moving only some of another list's elements
+  // moves them into new nodes here instead, in O(k); T is moved, never
+  // copied. The same happens for a whole other whose allocator compares
+  // unequal to ours or that draws from a different pool.
   void splice(const_iterator pos, list &other);
+  void splice(const_iterator pos, list &other, const_iterator it);
+  void splice(const_iterator pos, list &other, const_iterator first,
+              const_iterator last);
+  // Inserts before pos and returns the new element.
   iterator insert(iterator pos, const_reference value);
   void reverse();
   void unique();
+  // On a shared_pool these act on the shared pool.
+  void reserve_nodes(size_type n);
+  void shrink_to_fit();
+
+ private:
+  node_pool<Node> m_pool;
+  shared_pool *m_shared = nullptr;
+
+  template <typename... Args>
+  Node *create_node(Args &&...args);
+  void destroy_node(Node *node);
+  void destroy_node_memory(Node *node) noexcept;
+  bool shares_pool(const list &other) const noexcept {
+    return m_shared != nullptr && m_shared == other.m_shared;
+  }
+  void append_all(const list &other);
+  static Node *as_node(NodeBase *node) { return static_cast<Node *>(node); }
+  static const Node *as_node(const NodeBase *node) {
+    return static_cast<const Node *>(node);
+  }
+  void reset_sentinel() noexcept;
+  void relink_sentinel() noexcept;
+  NodeBase *open_chain() noexcept;
+  template <typename Compare>
+  static NodeBase *merge_runs(NodeBase *a, NodeBase *b, Compare &comp);
+  void relink_prev(NodeBase *first) noexcept;
+  NodeBase *take_all(list &other, NodeBase *&last);
+  void link_range(NodeBase *pos, NodeBase *first, NodeBase *last) noexcept;
+  void unlink_range(NodeBase *first, NodeBase *last) noexcept;
 };
 
-template <typename T>
-list<T>::list() noexcept : m_head(nullptr), m_tail(nullptr), m_size(0){};
-
-template <typename T>
-list<T>::list(size_type n) : m_head(nullptr), m_tail(nullptr), m_size(0) {
+template <typename T, typename Allocator>
+list<T, Allocator>::list() noexcept
+    : m_sentinel{&m_sentinel, &m_sentinel}, m_size(0){};
+
+template <typename T, typename Allocator>
+list<T, Allocator>::list(const Allocator &alloc) noexcept
+    : allocator_base<node_allocator>(node_allocator(alloc)),
+      m_sentinel{&m_sentinel, &m_sentinel},
+      m_size(0) {}
+
+template <typename T, typename Allocator>
+list<T, Allocator>::list(shared_pool &pool) noexcept
+    : allocator_base<node_allocator>(pool.get_allocator()),
+      m_sentinel{&m_sentinel, &m_sentinel},
+      m_size(0),
+      m_shared(&pool) {}
+
+template <typename T, typename Allocator>
+list<T, Allocator>::list(size_type n, const Allocator &alloc) : list(alloc) {
   for (size_type i = 0; i < n; i++) {
     push_back(T());
   }
 };
 
-template <typename T>
-list<T>::list(list<T> &&other) noexcept
-    : m_head(other.m_head), m_tail(other.m_tail), m_size(other.m_size) {
+template <typename T, typename Allocator>
+list<T, Allocator>::list(list<T, Allocator> &&other) noexcept
+    : allocator_base<node_allocator>(std::move(other.alloc())),
+      m_sentinel(other.m_sentinel),
+      m_size(other.m_size),
+      m_pool(std::move(other.m_pool)),
+      m_shared(other.m_shared) {
+  relink_sentinel();
   other.m_size = 0;
-  other.m_head = nullptr;
-  other.m_tail = nullptr;
+  other.reset_sentinel();
 }
 
-template <typename T>
-list<T>::list(const list<T> &copy)
-    : m_head(nullptr), m_tail(nullptr), m_size(0) {
-  Node *temp = copy.m_head;
-  while (temp) {
-    push_back(temp->data);
-    temp = temp->next;
-  }
+template <typename T, typename Allocator>
+list<T, Allocator>::list(const list<T, Allocator> &copy)
+    : list(copy, node_traits::select_on_container_copy_construction(
+                     copy.alloc())) {}
+
+template <typename T, typename Allocator>
+list<T, Allocator>::list(const list<T, Allocator> &copy,
+                         const Allocator &alloc)
+    : list(alloc) {
+  append_all(copy);
 }
 
-template <typename T>
-list<T>::list(std::initializer_list<T> const &initList) {
-  m_head = nullptr;
-  m_tail = nullptr;
-  m_size = 0;
+template <typename T, typename Allocator>
+list<T, Allocator>::list(std::initializer_list<T> const &initList,
+                         const Allocator &alloc)
+    : list(alloc) {
   for (const T &value : initList) {
     push_back(value);
   }
-  m_size = initList.size();
 };
 
-template <typename T>
-void list<T>::clear() {
-  Node *current = m_head;
-  while (current != nullptr) {
-    Node *next = current->next;
+template <typename T, typename Allocator>
+typename list<T, Allocator>::allocator_type list<T, Allocator>::get_allocator()
+    const {
+  return allocator_type(this->alloc());
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename list<T, Allocator>::Node *list<T, Allocator>::create_node(
+    Args &&...args) {
+  Node *node = m_shared != nullptr ? m_shared->allocate()
+                                   : m_pool.allocate(this->alloc());
+  try {
+    node_traits::construct(this->alloc(), node, std::forward<Args>(args)...);
+  } catch (...) {
+    destroy_node_memory(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::destroy_node(Node *node) {
+  node_traits::destroy(this->alloc(), node);
+  destroy_node_memory(node);
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::destroy_node_memory(Node *node) noexcept {
+  if (m_shared != nullptr) {
+    m_shared->deallocate(node);
+  } else {
+    m_pool.deallocate(node);
+  }
+}
 
-    delete current;
-    current = nullptr;
+template <typename T, typename Allocator>
+void list<T, Allocator>::reserve_nodes(size_type n) {
+  if (m_shared != nullptr) {
+    m_shared->reserve(n);
+  } else {
+    m_pool.reserve(this->alloc(), n);
+  }
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::shrink_to_fit() {
+  if (m_shared != nullptr) {
+    m_shared->shrink_to_fit();
+  } else {
+    m_pool.shrink_to_fit(this->alloc());
+  }
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::append_all(const list &other) {
+  for (const NodeBase *node = other.m_sentinel.next;
+       node != &other.m_sentinel; node = node->next) {
+    push_back(as_node(node)->data);
+  }
+}
+
+// The sentinel of an empty list links to itself.
+template <typename T, typename Allocator>
+void list<T, Allocator>::reset_sentinel() noexcept {
+  m_sentinel.next = m_sentinel.prev = &m_sentinel;
+}
+
+// Points the first and last element back at this list's sentinel after its
+// links were copied from another list; m_size must already be set.
+template <typename T, typename Allocator>
+void list<T, Allocator>::relink_sentinel() noexcept {
+  if (m_size == 0) {
+    reset_sentinel();
+  } else {
+    m_sentinel.next->prev = &m_sentinel;
+    m_sentinel.prev->next = &m_sentinel;
+  }
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::clear() {
+  NodeBase *current = m_sentinel.next;
+  while (current != &m_sentinel) {
+    NodeBase *next = current->next;
+    destroy_node(as_node(current));
     current = next;
   }
-  m_head = m_tail = nullptr;
+  reset_sentinel();
   m_size = 0;
 }
 
-template <typename T>
-list<T>::~list() {
-  list<T>::clear();
+template <typename T, typename Allocator>
+list<T, Allocator>::~list() {
+  list<T, Allocator>::clear();
+  m_pool.release(this->alloc());
 }
 
-template <typename T>
-list<T> &list<T>::operator=(const list<T> &other) {
-  list copy(other);
-  *this = std::move(copy);
+template <typename T, typename Allocator>
+list<T, Allocator> &list<T, Allocator>::operator=(
+    const list<T, Allocator> &other) {
+  if (this != &other) {
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      if (this->alloc() != other.alloc()) {
+        clear();
+        m_pool.release(this->alloc());
+      }
+    }
+    propagate_on_copy(this->alloc(), other.alloc());
+    clear();
+    append_all(other);
+  }
   return *this;
 }
 
-template <typename T>
-list<T> &list<T>::operator=(list &&other) noexcept {
+template <typename T, typename Allocator>
+list<T, Allocator> &list<T, Allocator>::operator=(list &&other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value ||
+    node_traits::is_always_equal::value) {
   if (this != &other) {
     clear();
-
-    std::swap(m_size, other.m_size);
-    std::swap(m_head, other.m_head);
-    std::swap(m_tail, other.m_tail);
+    if (m_shared == other.m_shared &&
+        can_steal_on_move(this->alloc(), other.alloc())) {
+      m_pool.release(this->alloc());
+      propagate_on_move(this->alloc(), other.alloc());
+      m_sentinel = other.m_sentinel;
+      m_size = other.m_size;
+      relink_sentinel();
+      other.m_size = 0;
+      other.reset_sentinel();
+      m_pool.swap(other.m_pool);
+    } else {
+      for (NodeBase *node = other.m_sentinel.next; node != &other.m_sentinel;
+           node = node->next) {
+        Node *el = create_node(std::move(as_node(node)->data));
+        link_range(&m_sentinel, el, el);
+        m_size++;
+      }
+      other.clear();
+    }
   }
 
   return *this;
 }
 
-template <typename T>
-const T &list<T>::front() {
-  return m_head->data;
+template <typename T, typename Allocator>
+const T &list<T, Allocator>::front() {
+  return as_node(m_sentinel.next)->data;
 }
 
-template <typename T>
-const T &list<T>::back() {
-  Node *temp = m_head;
-  while (temp->next != nullptr) {
-    temp = temp->next;
-  }
-  return temp->data;
-}
-
-template <typename T>
-void list<T>::push_back(const T &v) {
-  Node *el = new Node(v);
-  el->data = v;
-  el->next = nullptr;
-  el->prev = nullptr;
-  if (m_tail == nullptr) {
-    m_head = el;
-    m_tail = el;
-  } else {
-    m_tail->next = el;
-    el->prev = m_tail;
-    m_tail = m_tail->next;
-  }
+template <typename T, typename Allocator>
+const T &list<T, Allocator>::back() {
+  return as_node(m_sentinel.prev)->data;
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::push_back(const T &v) {
+  Node *el = create_node(v);
+  link_range(&m_sentinel, el, el);
   m_size++;
 }
 
-template <typename T>
-void list<T>::pop_back() {
+template <typename T, typename Allocator>
+void list<T, Allocator>::pop_back() {
   if (m_size == 0) return;
-
-  Node *ptr = m_tail;
-  if (m_size == 1) {
-    m_head = m_tail = nullptr;
-  } else {
-    m_tail = m_tail->prev;
-    m_tail->next = nullptr;
-  }
-  delete ptr;
-  m_size--;
+  erase(iterator(m_sentinel.prev));
 }
 
-template <typename T>
-void list<T>::push_front(const T &v) {
-  Node *el = new Node(v);
-  if (m_head == nullptr) {
-    m_tail = el;
-  } else {
-    el->next = m_head;
-    m_head->prev = el;
-  }
-  m_head = el;
+template <typename T, typename Allocator>
+void list<T, Allocator>::push_front(const T &v) {
+  Node *el = create_node(v);
+  link_range(m_sentinel.next, el, el);
   m_size++;
 }
 
-template <typename T>
-void list<T>::pop_front() {
-  if (m_head == nullptr) return;
+template <typename T, typename Allocator>
+void list<T, Allocator>::pop_front() {
+  if (m_size == 0) return;
+  erase(iterator(m_sentinel.next));
+}
 
-  Node *ptr = m_head;
-  if (m_head == m_tail) {
-    m_head = nullptr;
-    m_tail = nullptr;
+template <typename T, typename Allocator>
+bool list<T, Allocator>::empty() const {
+  return m_size == 0;
+}
 
-  } else {
-    m_head = ptr->next;
-    m_head->prev = nullptr;
-  }
-  delete ptr;
-  --m_size;
+template <typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::begin() {
+  return iterator(m_sentinel.next);
 }
 
-template <typename T>
-bool list<T>::empty() const {
-  return m_head == nullptr;
+template <typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::end() {
+  return iterator(&m_sentinel);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::begin() {
-  return iterator(m_head);
+template <typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::erase(
+    iterator pos) {
+  NodeBase *erase_el = pos.getNodePtr();
+  if (erase_el == &m_sentinel) return end();
+
+  NodeBase *next_el = erase_el->next;
+  unlink_range(erase_el, erase_el);
+  destroy_node(as_node(erase_el));
+  m_size--;
+  return iterator(next_el);
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::end() {
-  return iterator(nullptr);
+template <typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::erase(
+    iterator first, iterator last) {
+  while (first != last) {
+    first = erase(first);
+  }
+  return last;
 }
 
-template <typename T>
-void list<T>::erase(iterator pos) {
-  Node *pos_Node = pos.getNodePtr();
+template <typename T, typename Allocator>
+void list<T, Allocator>::swap(list<T, Allocator> &other) {
+  propagate_on_swap(this->alloc(), other.alloc());
+  std::swap(m_sentinel, other.m_sentinel);
+  std::swap(m_size, other.m_size);
+  relink_sentinel();
+  other.relink_sentinel();
+  m_pool.swap(other.m_pool);
+  std::swap(m_shared, other.m_shared);
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::sort() {
+  sort(std::less<T>());
+}
+
+// Bottom-up: runs[i] is empty or holds a sorted run of 2^i nodes linked
+// through next only, like the bits of a counter. Each node is carried into
+// the counter as a run of one; runs are merged older-first so that equal
+// elements keep their order. prev links are rebuilt in a final pass.
+template <typename T, typename Allocator>
+template <typename Compare>
+void list<T, Allocator>::sort(Compare comp) {
+  if (m_size < 2) {
+    return;
+  }
+  NodeBase *runs[std::numeric_limits<std::size_t>::digits] = {};
+  std::size_t used = 0;
+  NodeBase *node = open_chain();
+  while (node != nullptr) {
+    NodeBase *run = node;
+    node = node->next;
+    run->next = nullptr;
+    std::size_t i = 0;
+    for (; i < used && runs[i] != nullptr; i++) {
+      run = merge_runs(runs[i], run, comp);
+      runs[i] = nullptr;
+    }
+    if (i == used) {
+      used++;
+    }
+    runs[i] = run;
+  }
+  NodeBase *sorted = nullptr;
+  for (std::size_t i = 0; i < used; i++) {
+    sorted = merge_runs(runs[i], sorted, comp);
+  }
+  relink_prev(sorted);
+}
 
-  if (pos_Node == nullptr) return;
-  if (pos_Node == m_head)
-    pop_front();
-  else if (pos_Node == m_tail)
-    pop_back();
-  else {
-    iterator it = iterator(m_head);
-    Node *erase_el = m_head;
-    while (pos != it) {
-      erase_el = erase_el->next;
-      it++;
+// Merges two sorted next-linked runs; on ties the node from a comes first.
+template <typename T, typename Allocator>
+template <typename Compare>
+typename list<T, Allocator>::NodeBase *list<T, Allocator>::merge_runs(
+    NodeBase *a, NodeBase *b, Compare &comp) {
+  NodeBase *result = nullptr;
+  NodeBase **tail = &result;
+  while (a != nullptr && b != nullptr) {
+    if (comp(as_node(b)->data, as_node(a)->data)) {
+      *tail = b;
+      b = b->next;
+    } else {
+      *tail = a;
+      a = a->next;
     }
-    Node *prev_el = erase_el->prev;
-    Node *next_el = erase_el->next;
-    prev_el->next = next_el;
-    next_el->prev = prev_el;
-    erase_el->next = nullptr;
-    erase_el->prev = nullptr;
-    delete erase_el;
-    m_size--;
+    tail = &(*tail)->next;
   }
+  *tail = a != nullptr ? a : b;
+  return result;
 }
 
-template <typename T>
-void list<T>::swap(list<T> &other) {
-  std::swap(m_head, other.m_head);
-  std::swap(m_tail, other.m_tail);
-  std::swap(m_size, other.m_size);
+// Opens the ring: returns the elements as a chain linked through next and
+// ending in nullptr. relink_prev() closes it again.
+template <typename T, typename Allocator>
+typename list<T, Allocator>::NodeBase *
+list<T, Allocator>::open_chain() noexcept {
+  if (m_size == 0) {
+    return nullptr;
+  }
+  m_sentinel.prev->next = nullptr;
+  return m_sentinel.next;
 }
 
-template <typename T>
-void list<T>::sort() {
-  if (m_size > 1) {
-    for (std::size_t i = 0; i < m_size; i++) {
-      Node *ptr = m_head;
-      for (std::size_t j = 0; j < m_size - i; j++) {
-        if (ptr->next != nullptr && ptr->next->data < ptr->data) {
-          T tmp = ptr->next->data;
-          ptr->next->data = ptr->data;
-          ptr->data = tmp;
-        }
-        ptr = ptr->next;
-      }
-    }
+// Makes first, a chain linked through next and ending in nullptr, the
+// contents of the list and restores the prev links and the ring.
+template <typename T, typename Allocator>
+void list<T, Allocator>::relink_prev(NodeBase *first) noexcept {
+  NodeBase *prev = &m_sentinel;
+  for (NodeBase *node = first; node != nullptr; node = node->next) {
+    prev->next = node;
+    node->prev = prev;
+    prev = node;
   }
+  prev->next = &m_sentinel;
+  m_sentinel.prev = prev;
 }
 
-template <typename T>
-void list<T>::merge(list<T> &other) {
-  Node *temp_other = other.m_head;
-  for (std::size_t j = 0; j < other.m_size; j++) {
-    push_back(temp_other->data);
-    temp_other = temp_other->next;
+// Empties other and returns its elements as a detached chain of nodes owned
+// by this list, first to last. Lists on the same shared_pool just pass the
+// nodes on; between unshared lists with equal allocators this list adopts
+// other's slabs along with the nodes; otherwise the elements are moved into
+// new nodes. The caller adds the count to m_size.
+template <typename T, typename Allocator>
+typename list<T, Allocator>::NodeBase *list<T, Allocator>::take_all(
+    list &other, NodeBase *&last) {
+  if (shares_pool(other) || (m_shared == nullptr &&
+                             other.m_shared == nullptr &&
+                             this->alloc() == other.alloc())) {
+    m_pool.adopt(this->alloc(), other.m_pool);
+    NodeBase *first = other.m_sentinel.next;
+    last = other.m_sentinel.prev;
+    other.m_size = 0;
+    other.reset_sentinel();
+    return first;
+  }
+  NodeBase chain{nullptr, nullptr};
+  last = &chain;
+  for (NodeBase *node = other.m_sentinel.next; node != &other.m_sentinel;
+       node = node->next) {
+    Node *el = create_node(std::move(as_node(node)->data));
+    el->prev = last;
+    last = last->next = el;
   }
-  sort();
+  other.clear();
+  return chain.next;
 }
 
-template <typename T>
-void list<T>::splice(const_iterator pos, list<T> &other) {
-  Node *pos_Node = const_cast<Node *>(pos.getNodePtr());
+// Links the detached chain first..last in before pos.
+template <typename T, typename Allocator>
+void list<T, Allocator>::link_range(NodeBase *pos, NodeBase *first,
+                                    NodeBase *last) noexcept {
+  NodeBase *prev = pos->prev;
+  first->prev = prev;
+  last->next = pos;
+  prev->next = first;
+  pos->prev = last;
+}
 
-  Node *pos_Node_next = const_cast<Node *>(pos.getNodePtr());
-  Node *temp_other = other.m_head;
+// Detaches first..last, leaving the chain's own inner links intact.
+template <typename T, typename Allocator>
+void list<T, Allocator>::unlink_range(NodeBase *first,
+                                      NodeBase *last) noexcept {
+  first->prev->next = last->next;
+  last->next->prev = first->prev;
+}
 
-  if (pos_Node == m_head) {
-    for (std::size_t i = 0; i < other.m_size - 1; i++) {
-      temp_other = temp_other->next;
+template <typename T, typename Allocator>
+void list<T, Allocator>::merge(list<T, Allocator> &other) {
+  merge(other, std::less<T>());
+}
+
+template <typename T, typename Allocator>
+template <typename Compare>
+void list<T, Allocator>::merge(list<T, Allocator> &other, Compare comp) {
+  if (this == &other || other.m_size == 0) {
+    return;
+  }
+  size_type count = other.m_size;
+  NodeBase *last;
+  NodeBase *theirs = take_all(other, last);
+  last->next = nullptr;
+  relink_prev(merge_runs(open_chain(), theirs, comp));
+  m_size += count;
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::splice(const_iterator pos, list<T, Allocator> &other) {
+  if (this == &other || other.m_size == 0) {
+    return;
+  }
+  size_type count = other.m_size;
+  NodeBase *last;
+  NodeBase *first = take_all(other, last);
+  link_range(const_cast<NodeBase *>(pos.getNodePtr()), first, last);
+  m_size += count;
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::splice(const_iterator pos, list<T, Allocator> &other,
+                                const_iterator it) {
+  const_iterator next = it;
+  splice(pos, other, it, ++next);
+}
+
+template <typename T, typename Allocator>
+void list<T, Allocator>::splice(const_iterator pos, list<T, Allocator> &other,
+                                const_iterator first, const_iterator last) {
+  if (first == last) {
+    return;
+  }
+  NodeBase *pos_node = const_cast<NodeBase *>(pos.getNodePtr());
+  NodeBase *first_node = const_cast<NodeBase *>(first.getNodePtr());
+  NodeBase *last_node = const_cast<NodeBase *>(last.getNodePtr());
+  if (this == &other) {
+    if (pos_node == first_node || pos_node == last_node) {
+      return;
     }
-    temp_other->next = m_head;
-    m_head = other.m_head;
-  } else {
-    pos_Node = pos_Node->prev;
-    for (std::size_t i = 0; i < other.m_size; i++) {
-      pos_Node->next = temp_other;
-      pos_Node->next->prev = pos_Node;
-      temp_other = temp_other->next;
-      pos_Node = pos_Node->next;
+    NodeBase *tail = last_node->prev;
+    unlink_range(first_node, tail);
+    link_range(pos_node, first_node, tail);
+    return;
+  }
+  if (shares_pool(other)) {
+    size_type count = 0;
+    for (NodeBase *node = first_node; node != last_node; node = node->next) {
+      count++;
     }
-    pos_Node->next = pos_Node_next;
+    NodeBase *tail = last_node->prev;
+    other.unlink_range(first_node, tail);
+    other.m_size -= count;
+    link_range(pos_node, first_node, tail);
+    m_size += count;
+    return;
+  }
+  while (first_node != last_node) {
+    Node *el = create_node(std::move(as_node(first_node)->data));
+    link_range(pos_node, el, el);
+    m_size++;
+    first_node = other.erase(iterator(first_node)).getNodePtr();
   }
-  other.m_head = nullptr;
-  other.m_tail = nullptr;
-  m_size += other.m_size;
-  other.m_size = 0;
 }
 
-template <typename T>
-typename list<T>::size_type list<T>::max_size() {
+template <typename T, typename Allocator>
+typename list<T, Allocator>::size_type list<T, Allocator>::max_size() {
   return std::numeric_limits<std::size_t>::max() / sizeof(T);
 }
 
-template <typename T>
-typename list<T>::size_type list<T>::size() {
+template <typename T, typename Allocator>
+typename list<T, Allocator>::size_type list<T, Allocator>::size() {
   return m_size;
 }
 
-template <typename T>
-typename list<T>::iterator list<T>::insert(list<T>::iterator pos,
-                                           list<T>::const_reference value) {
-  Node *ptr = pos.getNodePtr();
-  if (ptr == m_head) {
-    Node *newNode = new Node(value);
-    newNode->next = m_head;
-    if (m_head != nullptr) {
-      m_head->prev = newNode;
-    }
-    m_head = newNode;
-    if (m_tail == nullptr) {
-      m_tail = newNode;
-    }
-  } else {
-    Node *current = m_head;
-    while (current != nullptr && current->next != ptr) {
-      current = current->next;
-    }
-    if (current != nullptr) {
-      Node *newNode = new Node(value);
-      newNode->next = current->next;
-      if (current->next != nullptr) {
-        current->next->prev = newNode;
-      }
-      current->next = newNode;
-      if (newNode->next == nullptr) {
-        m_tail = newNode;
-      }
-    }
-  }
+template <typename T, typename Allocator>
+typename list<T, Allocator>::iterator list<T, Allocator>::insert(
+    list<T, Allocator>::iterator pos,
+    list<T, Allocator>::const_reference value) {
+  Node *newNode = create_node(value);
+  link_range(pos.getNodePtr(), newNode, newNode);
   m_size++;
-  return iterator(ptr);
+  return iterator(newNode);
 }
 
-template <typename T>
-void list<T>::reverse() {
-  Node *temp_head = m_head;
-  Node *temp_tail = m_tail;
-  value_type val = m_head->data;
-  if (temp_head == m_tail) {
-    return;
-  } else {
-    for (size_type i = 0; i < m_size / 2; i++) {
-      val = temp_head->data;
-      temp_head->data = temp_tail->data;
-      temp_tail->data = val;
-      temp_head = temp_head->next;
-      temp_tail = temp_tail->prev;
-    }
-  }
+// Swaps next and prev in every node, the sentinel included; no element is
+// copied or moved.
+template <typename T, typename Allocator>
+void list<T, Allocator>::reverse() {
+  NodeBase *node = &m_sentinel;
+  do {
+    std::swap(node->next, node->prev);
+    node = node->prev;
+  } while (node != &m_sentinel);
 }
 
-template <typename T>
-void list<T>::unique() {
-  auto it1 = begin();
-  ++it1;
-  if (m_head == nullptr || m_head == m_tail) return;
-  for (auto it = it1; it != end(); ++it) {
-    auto it2 = it;
-    --it2;
-    if (*it == *it2) {
-      // --it2;
-      erase(it2);
+template <typename T, typename Allocator>
+void list<T, Allocator>::unique() {
+  if (m_size < 2) return;
+  NodeBase *node = m_sentinel.next;
+  while (node->next != &m_sentinel) {
+    if (as_node(node->next)->data == as_node(node)->data) {
+      erase(iterator(node->next));
+    } else {
+      node = node->next;
     }
   }
 }
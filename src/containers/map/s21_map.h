@@ -7,30 +7,49 @@
 #include "../s21_bntree.h"
 
 namespace s21 {
-template <class Key, class Value>
-class map : public tree<Key, Value> {
+template <class Key, class Value, class Compare = std::less<Key>,
+          class Allocator = std::allocator<std::pair<const Key, Value>>>
+class map : public tree<Key, Value, Compare, Allocator> {
  public:
   class MapIterator;
   class ConstMapIterator;
   using key_type = Key;
   using value_type = Value;
   using mapped_type = std::pair<key_type, value_type>;
-  using reference = mapped_type &;
-  using const_reference = const mapped_type &;
+  using reference = std::pair<const key_type, value_type> &;
+  using const_reference = const std::pair<const key_type, value_type> &;
+  using pointer = std::pair<const key_type, value_type> *;
+  using const_pointer = const std::pair<const key_type, value_type> *;
   using iterator = MapIterator;
   using const_iterator = ConstMapIterator;
   using size_type = size_t;
+  using key_compare = Compare;
 
-  class MapIterator : public tree<Key, Value>::Iterator {
-   protected:
-    value_type &return_value();
-
+  class MapIterator : public tree<Key, Value, Compare, Allocator>::Iterator {
    public:
-    MapIterator() : tree<Key, Value>::Iterator(){};
-    MapIterator(typename tree<Key, Value>::Node *node,
-                typename tree<Key, Value>::Node *past_node = nullptr)
-        : tree<Key, Value>::Iterator(node, past_node = nullptr){};
-    reference &operator*();
+    MapIterator() : tree<Key, Value, Compare, Allocator>::Iterator(){};
+    MapIterator(typename tree<Key, Value, Compare, Allocator>::NodeBase *node)
+        : tree<Key, Value, Compare, Allocator>::Iterator(node){};
+    reference operator*() const;
+    pointer operator->() const { return &**this; }
+    MapIterator &operator++() {
+      tree<Key, Value, Compare, Allocator>::Iterator::operator++();
+      return *this;
+    }
+    MapIterator operator++(int) {
+      MapIterator temp = *this;
+      ++*this;
+      return temp;
+    }
+    MapIterator &operator--() {
+      tree<Key, Value, Compare, Allocator>::Iterator::operator--();
+      return *this;
+    }
+    MapIterator operator--(int) {
+      MapIterator temp = *this;
+      --*this;
+      return temp;
+    }
 
     friend class map;
   };
@@ -38,157 +57,250 @@ class map : public tree<Key, Value> {
    public:
     friend class map;
     ConstMapIterator() : MapIterator(){};
-    ConstMapIterator(typename tree<Key, Value>::Node *node,
-                     typename tree<Key, Value>::Node *past_node)
-        : MapIterator(node, past_node = nullptr){};
+    ConstMapIterator(
+        typename tree<Key, Value, Compare, Allocator>::NodeBase *node)
+        : MapIterator(node){};
     const_reference operator*() const { return MapIterator::operator*(); }
+    const_pointer operator->() const { return MapIterator::operator->(); }
   };
 
-  map() : tree<Key, Value>(){};
+  map() : tree<Key, Value, Compare, Allocator>(){};
+  explicit map(const Allocator &alloc)
+      : tree<Key, Value, Compare, Allocator>(alloc) {}
+  explicit map(const Compare &comp, const Allocator &alloc = Allocator())
+      : tree<Key, Value, Compare, Allocator>(comp, alloc) {}
   map(std::initializer_list<mapped_type> const &items) noexcept;
-  map(const map &other) : tree<Key, Value>(other){};
-  map(map &&other) noexcept : tree<Key, Value>(std::move(other)){};
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  map(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : tree<Key, Value, Compare, Allocator>(alloc) {
+    assign(first, last);
+  }
+  map(const map &other) : tree<Key, Value, Compare, Allocator>(other){};
+  map(map &&other) noexcept
+      : tree<Key, Value, Compare, Allocator>(std::move(other)){};
   map &operator=(const map &other);
-  map &operator=(map &&other) noexcept;
+  map &operator=(map &&other) noexcept(
+      std::is_nothrow_move_assignable_v<tree<Key, Value, Compare, Allocator>>);
   ~map() = default;
 
   std::pair<iterator, bool> insert(const mapped_type &value) {
-    std::pair<typename tree<Key, Value>::iterator, bool> tr =
-        tree<Key, Value>::insert(value.first, value.second);
-    std::pair<typename map<Key, Value>::iterator, bool> map_pair;
-    map_pair.first = MapIterator(find(value.first));
-    map_pair.second = tr.second;
-    return map_pair;
+    return insert(value.first, value.second);
   }
   std::pair<iterator, bool> insert(const Key &key, const Value &value) {
-    std::pair<typename tree<Key, Value>::iterator, bool> tr =
-        tree<Key, Value>::insert(key, value);
-    std::pair<typename map<Key, Value>::iterator, bool> map_pair;
-    map_pair.first = MapIterator(find(key));
-    map_pair.second = tr.second;
-    return map_pair;
-  }
-
-  std::pair<iterator, bool> insert_or_assign(const Key &key,
-                                             const Value &value) {
-    if (find(key) != nullptr) {
-      map<Key, Value>::erase(find(key));
-      return map<Key, Value>::insert(key, value);
+    auto inserted =
+        tree<Key, Value, Compare, Allocator>::insert_node(key, value);
+    return {MapIterator(inserted.first), inserted.second};
+  }
+
+  // Assigns in place when key is present. second is true either way, as it
+  // has always been for this map.
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key &key, M &&obj) {
+    auto inserted = tree<Key, Value, Compare, Allocator>::insert_node(
+        key, std::forward<M>(obj));
+    if (!inserted.second) {
+      inserted.first->n_data.second = std::forward<M>(obj);
     }
-    return map<Key, Value>::insert(key, value);
+    return {MapIterator(inserted.first), true};
+  }
+  // Constructs the value from args only if key is not present yet.
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    auto inserted = tree<Key, Value, Compare, Allocator>::insert_node(
+        key, std::forward<Args>(args)...);
+    return {MapIterator(inserted.first), inserted.second};
+  }
+  // Replaces the contents with [first, last), keeping the first of equal
+  // keys. Input already sorted by key without duplicates is built in linear
+  // time; anything else is sorted first.
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  void assign(InputIt first, InputIt last) {
+    tree<Key, Value, Compare, Allocator>::assign_unique(
+        first, last, [](const auto &item) {
+          return std::pair<const Key &, const Value &>(item.first,
+                                                       item.second);
+        });
   }
   bool contains(const Key &key);
   void erase(iterator pos);
   iterator begin();
   iterator end();
   iterator find(const Key &key);
+  // The element at sorted position k, or end() when k >= size(); O(log n).
+  iterator nth(size_type k) {
+    return MapIterator(tree<Key, Value, Compare, Allocator>::select_node(k));
+  }
+  // The first element whose key is not less than key, and the first whose
+  // key is greater.
+  iterator lower_bound(const Key &key) {
+    return MapIterator(
+        tree<Key, Value, Compare, Allocator>::lower_bound_node(key));
+  }
+  iterator upper_bound(const Key &key) {
+    return MapIterator(
+        tree<Key, Value, Compare, Allocator>::upper_bound_node(key));
+  }
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    auto nodes = tree<Key, Value, Compare, Allocator>::equal_range_nodes(key);
+    return {MapIterator(nodes.first), MapIterator(nodes.second)};
+  }
+  // Lookups by any type the comparator can order against Key, such as
+  // std::string_view for std::string keys with std::less<>, when Compare
+  // declares is_transparent. No temporary Key is built.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return tree<Key, Value, Compare, Allocator>::find_node(key) != nullptr;
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    auto node = tree<Key, Value, Compare, Allocator>::find_node(key);
+    return node == nullptr ? end() : MapIterator(node);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return MapIterator(
+        tree<Key, Value, Compare, Allocator>::lower_bound_node(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return MapIterator(
+        tree<Key, Value, Compare, Allocator>::upper_bound_node(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    auto nodes = tree<Key, Value, Compare, Allocator>::equal_range_nodes(key);
+    return {MapIterator(nodes.first), MapIterator(nodes.second)};
+  }
+  // The elements with keys in [lo, hi), read in place as the range is
+  // iterated. Empty when hi <= lo.
+  iterator_range<iterator> range(const Key &lo, const Key &hi) {
+    iterator first = lower_bound(lo);
+    return {first, this->key_comp()(hi, lo) ? first : lower_bound(hi)};
+  }
   Value &at(const Key &key);
   Value &operator[](const Key &key);
-
- protected:
-  static inline std::pair<key_type, value_type> pr{};
 };
 
-template <typename Key, typename Value>
-bool map<Key, Value>::contains(const Key &key) {
-  return find(key) != nullptr;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool map<Key, Value, Compare, Allocator>::contains(const Key &key) {
+  return tree<Key, Value, Compare, Allocator>::find_node(key) != nullptr;
 }
 
-template <typename Key, typename Value>
-void map<Key, Value>::erase(typename map<Key, Value>::MapIterator pos) {
-  if (pos.it_node == nullptr || tree<Key, Value>::t_root == nullptr) return;
-  tree<Key, Value>::t_root = tree<Key, Value>::recursive_delete(
-      tree<Key, Value>::t_root, (*pos).first);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void map<Key, Value, Compare, Allocator>::erase(
+    typename map<Key, Value, Compare, Allocator>::MapIterator pos) {
+  tree<Key, Value, Compare, Allocator>::erase(pos);
 }
 
-template <typename Key, typename Value>
-typename map<Key, Value>::MapIterator map<Key, Value>::find(const Key &key) {
-  typename tree<Key, Value>::Node *node =
-      tree<Key, Value>::recursive_find(tree<Key, Value>::t_root, key);
-  return MapIterator(node);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename map<Key, Value, Compare, Allocator>::MapIterator
+map<Key, Value, Compare, Allocator>::find(const Key &key) {
+  typename tree<Key, Value, Compare, Allocator>::Node *node =
+      tree<Key, Value, Compare, Allocator>::find_node(key);
+  return node == nullptr ? end() : MapIterator(node);
 }
 
-template <typename Key, typename Value>
-typename map<Key, Value>::iterator map<Key, Value>::begin() {
-  return map<Key, Value>::MapIterator(
-      tree<Key, Value>::get_min(tree<Key, Value>::t_root));
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename map<Key, Value, Compare, Allocator>::iterator
+map<Key, Value, Compare, Allocator>::begin() {
+  return MapIterator(tree<Key, Value, Compare, Allocator>::first_node());
 }
 
-template <typename Key, typename Value>
-typename map<Key, Value>::iterator map<Key, Value>::end() {
-  if (tree<Key, Value>::t_root == nullptr) {
-    return map<Key, Value>::begin();
-  }
-
-  typename tree<Key, Value>::Node *last_node =
-      tree<Key, Value>::get_max(tree<Key, Value>::t_root);
-  MapIterator test(nullptr, last_node);
-  return test;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename map<Key, Value, Compare, Allocator>::iterator
+map<Key, Value, Compare, Allocator>::end() {
+  return MapIterator(&this->t_header);
 }
 
-template <typename Key, typename Value>
-typename map<Key, Value>::reference map<Key, Value>::MapIterator::operator*() {
-  if (tree<Key, Value>::Iterator::it_node == nullptr) {
-    static mapped_type fake{};
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename map<Key, Value, Compare, Allocator>::reference
+map<Key, Value, Compare, Allocator>::MapIterator::operator*() const {
+  if (tree<Key, Value, Compare, Allocator>::Iterator::it_node == nullptr) {
+    static std::pair<const key_type, value_type> fake{};
     return fake;
   }
-  pr.first = tree<Key, Value>::Iterator::it_node->n_key;
-  pr.second = tree<Key, Value>::Iterator::it_node->n_value;
-  std::pair<key_type, value_type> &ref = pr;
-  return ref;
+  return tree<Key, Value, Compare, Allocator>::as_node(
+             tree<Key, Value, Compare, Allocator>::Iterator::it_node)
+      ->n_data;
 }
 
-template <typename Key, typename Value>
-Value &map<Key, Value>::at(const Key &key) {
-  iterator a = find(key);
-  if (a == nullptr) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Value &map<Key, Value, Compare, Allocator>::at(const Key &key) {
+  typename tree<Key, Value, Compare, Allocator>::Node *node =
+      tree<Key, Value, Compare, Allocator>::find_node(key);
+  if (node == nullptr) {
     throw std::out_of_range("there is no such key in the map");
   }
-  return a.return_value();
+  return node->n_data.second;
 }
 
-template <typename Key, typename Value>
-Value &map<Key, Value>::operator[](const Key &key) {
-  auto it = find(key);
-  if (it == nullptr) {
-    static const Value fake{};
-    auto n = insert(key, fake);
-    it = n.first;
-  }
-  return it.return_value();
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Value &map<Key, Value, Compare, Allocator>::operator[](const Key &key) {
+  return tree<Key, Value, Compare, Allocator>::insert_node(key)
+      .first->n_data.second;
 }
 
-template <typename Key, typename Value>
-Value &map<Key, Value>::MapIterator::return_value() {
-  if (tree<Key, Value>::Iterator::it_node == nullptr) {
-    static Value fake{};
-    return fake;
-  }
-  return tree<Key, Value>::Iterator::it_node->n_value;
-}
-
-template <typename Key, typename Value>
-map<Key, Value> &map<Key, Value>::operator=(const map &other) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+map<Key, Value, Compare, Allocator> &
+map<Key, Value, Compare, Allocator>::operator=(const map &other) {
   if (this != &other) {
-    tree<Key, Value>::operator=(other);
+    tree<Key, Value, Compare, Allocator>::operator=(other);
   }
   return *this;
 }
 
-template <typename Key, typename Value>
-map<Key, Value> &map<Key, Value>::operator=(map &&other) noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+map<Key, Value, Compare, Allocator> &
+map<Key, Value, Compare, Allocator>::operator=(map &&other) noexcept(
+    std::is_nothrow_move_assignable_v<tree<Key, Value, Compare, Allocator>>) {
   if (this != &other) {
-    tree<Key, Value>::operator=(std::move(other));
+    tree<Key, Value, Compare, Allocator>::operator=(std::move(other));
   }
   return *this;
 }
 
-template <typename Key, typename Value>
-map<Key, Value>::map(std::initializer_list<mapped_type> const &items) noexcept {
-  for (auto i = items.begin(); i != items.end(); ++i) {
-    tree<Key, Value>::insert(i->first, i->second);
-  }
+template <typename Key, typename Value, typename Compare, typename Allocator>
+map<Key, Value, Compare, Allocator>::map(
+    std::initializer_list<mapped_type> const &items) noexcept {
+  assign(items.begin(), items.end());
 };
+
+// Set algebra on the keys of two maps, built into a new map with a's
+// comparator and allocator. Where keys match, the value comes from a. See
+// tree::assign_union().
+template <typename Key, typename Value, typename Compare, typename Allocator>
+map<Key, Value, Compare, Allocator> set_union(
+    const map<Key, Value, Compare, Allocator> &a,
+    const map<Key, Value, Compare, Allocator> &b) {
+  map<Key, Value, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assign_union(a, b);
+  return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+map<Key, Value, Compare, Allocator> set_intersection(
+    const map<Key, Value, Compare, Allocator> &a,
+    const map<Key, Value, Compare, Allocator> &b) {
+  map<Key, Value, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assign_intersection(a, b);
+  return result;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+map<Key, Value, Compare, Allocator> set_difference(
+    const map<Key, Value, Compare, Allocator> &a,
+    const map<Key, Value, Compare, Allocator> &b) {
+  map<Key, Value, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assign_difference(a, b);
+  return result;
+}
 }  // namespace s21
 
-#endif
\ No newline at end of file
+#endif
@@ -8,138 +8,182 @@
 #include "../s21_bntree.h"
 
 namespace s21 {
-template <typename T>
-class multiset : public list<T> {
+// Elements are kept in a list sorted by Compare; equivalent elements stay in
+// insertion order. Lookups taking K instead of T are available when Compare
+// declares is_transparent.
+template <typename T, typename Compare = std::less<T>,
+          typename Allocator = std::allocator<T>>
+class multiset : public list<T, Allocator>, private compare_base<Compare> {
  public:
   using key_type = T;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
-  using iterator = typename list<T>::List_Iterator;
-  using const_iterator = typename list<T>::Const_List_Iterator;
+  using iterator = typename list<T, Allocator>::List_Iterator;
+  using const_iterator = typename list<T, Allocator>::Const_List_Iterator;
   using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
 
-  multiset() : list<T>(){};
+  multiset() : list<T, Allocator>(){};
+  explicit multiset(const Allocator &alloc) : list<T, Allocator>(alloc) {}
+  explicit multiset(const Compare &comp, const Allocator &alloc = Allocator())
+      : list<T, Allocator>(alloc), compare_base<Compare>(comp) {}
   multiset(std::initializer_list<value_type> const &items) {
     for (auto i = items.begin(); i != items.end(); ++i) {
       insert(*i);
     }
   }
-  multiset(const multiset &other) : list<T>(other){};
-  multiset(multiset &&other) noexcept : list<T>(std::move(other)){};
+  multiset(const multiset &other)
+      : list<T, Allocator>(other), compare_base<Compare>(other.comp()){};
+  multiset(multiset &&other) noexcept
+      : list<T, Allocator>(std::move(other)),
+        compare_base<Compare>(other.comp()){};
   multiset &operator=(const multiset &other) {
     if (this != &other) {
-      list<T>::operator=(other);
+      list<T, Allocator>::operator=(other);
+      this->comp() = other.comp();
     }
     return *this;
   }
-  multiset &operator=(multiset &&other) noexcept {
+  multiset &operator=(multiset &&other) noexcept(
+      std::is_nothrow_move_assignable_v<list<T, Allocator>>) {
     if (this != &other) {
-      list<T>::operator=(std::move(other));
+      list<T, Allocator>::operator=(std::move(other));
+      this->comp() = other.comp();
     }
     return *this;
   }
   ~multiset() = default;
 
-  iterator find(const T &key) {
-    auto it = list<T>::begin();
-    for (; it != list<T>::end(); it++) {
-      if (it.list<T>::List_Iterator::getNodePtr() != nullptr && *it == key) {
-        return it;
-      }
-    }
-    return list<T>::end();
-  }
+  key_compare key_comp() const { return this->comp(); }
+
+  // Inserts value after the elements equivalent to it and returns an
+  // iterator to the new element.
   iterator insert(const value_type &value) {
-    iterator it = find(value);
-    iterator it1 = find(value);
-    int count = 0;
-    while (it.list<T>::List_Iterator::getNodePtr() != nullptr && *it1 == *it) {
-      ++it1;
-      count++;
-    }
-    if (count) {
-      --it1;
-      count--;
-    }
+    return list<T, Allocator>::insert(upper_bound_of(value), value);
+  }
 
-    list<T>::insert(list<T>::begin(), value);
-    list<T>::sort();
-    iterator it2 = find(value);
-    for (int i = 0; i < count; i++) {
-      ++it2;
-    }
-    return it2;
+  // Both lists are sorted, so other's nodes are merged in one pass; they go
+  // after the equivalent elements already here.
+  void merge(multiset &other) {
+    list<T, Allocator>::merge(other, this->comp());
   }
 
-  void merge(multiset<T> &other) {
-    typename list<T>::Node *temp_other = other.m_head;
-    for (std::size_t j = 0; j < other.size(); j++) {
-      list<T>::push_back(temp_other->data);
-      temp_other = temp_other->next;
-    }
-    other.clear();
-    list<T>::sort();
+  typename list<T, Allocator>::Node *getNodePtr() {
+    return list<T, Allocator>::Const_List_Iterator::getNodePtr();
+  }
+
+  iterator find(const T &key) { return find_of(key); }
+  size_type count(const T &key) { return count_of(key); }
+  bool contains(const T &key) { return find_of(key) != this->end(); }
+  std::pair<iterator, iterator> equal_range(const T &key) {
+    return equal_range_of(key);
   }
-  size_type count(const T &key);
+  iterator lower_bound(const T &key) { return lower_bound_of(key); }
+  iterator upper_bound(const T &key) { return upper_bound_of(key); }
 
-  typename list<T>::Node *getNodePtr() {
-    return list<T>::Const_List_Iterator::getNodePtr();
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    return find_of(key);
   }
-  bool contains(const T &key);
-  std::pair<iterator, iterator> equal_range(const T &key);
-  iterator lower_bound(const T &key);
-  iterator upper_bound(const T &key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K &key) {
+    return count_of(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K &key) {
+    return find_of(key) != this->end();
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    return equal_range_of(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return lower_bound_of(key);
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return upper_bound_of(key);
+  }
+
+ private:
+  template <typename K>
+  iterator find_of(const K &key);
+  template <typename K>
+  size_type count_of(const K &key);
+  template <typename K>
+  std::pair<iterator, iterator> equal_range_of(const K &key);
+  template <typename K>
+  iterator lower_bound_of(const K &key);
+  template <typename K>
+  iterator upper_bound_of(const K &key);
 };
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::lower_bound(const T &key) {
-  iterator it = list<T>::begin();
-  while (it.getNodePtr() != nullptr && *it < key) {
+template <typename T, typename Compare, typename Allocator>
+template <typename K>
+typename multiset<T, Compare, Allocator>::iterator
+multiset<T, Compare, Allocator>::lower_bound_of(const K &key) {
+  iterator it = list<T, Allocator>::begin();
+  while (it != list<T, Allocator>::end() && this->comp()(*it, key)) {
     ++it;
   }
   return it;
 }
 
-template <typename T>
-typename multiset<T>::iterator multiset<T>::upper_bound(const T &key) {
-  iterator it = list<T>::begin();
-  while (it.getNodePtr() != nullptr && *it <= key) {
+template <typename T, typename Compare, typename Allocator>
+template <typename K>
+typename multiset<T, Compare, Allocator>::iterator
+multiset<T, Compare, Allocator>::upper_bound_of(const K &key) {
+  iterator it = list<T, Allocator>::begin();
+  while (it != list<T, Allocator>::end() && !this->comp()(key, *it)) {
     ++it;
   }
   return it;
 }
 
-template <typename T>
-std::pair<typename multiset<T>::iterator, typename multiset<T>::iterator>
-multiset<T>::equal_range(const T &key) {
-  iterator it = find(key);
-  iterator it1 = find(key);
-  while (it.getNodePtr() != nullptr && it1.getNodePtr() != nullptr &&
-         *it1 == *it) {
-    ++it1;
+template <typename T, typename Compare, typename Allocator>
+template <typename K>
+std::pair<typename multiset<T, Compare, Allocator>::iterator,
+          typename multiset<T, Compare, Allocator>::iterator>
+multiset<T, Compare, Allocator>::equal_range_of(const K &key) {
+  iterator first = lower_bound_of(key);
+  iterator last = first;
+  while (last != list<T, Allocator>::end() && !this->comp()(key, *last)) {
+    ++last;
   }
-
-  return std::make_pair(it, it1);
+  return std::make_pair(first, last);
 }
 
-template <typename T>
-bool multiset<T>::contains(const T &key) {
-  return find(key) != list<T>::end();
+template <typename T, typename Compare, typename Allocator>
+template <typename K>
+typename multiset<T, Compare, Allocator>::iterator
+multiset<T, Compare, Allocator>::find_of(const K &key) {
+  iterator it = lower_bound_of(key);
+  if (it != list<T, Allocator>::end() && this->comp()(key, *it)) {
+    return list<T, Allocator>::end();
+  }
+  return it;
 }
 
-template <typename T>
-size_t multiset<T>::count(const T &key) {
-  iterator it = find(key);
-  iterator it1 = find(key);
-  size_t count = 0;
-  while (it.getNodePtr() != nullptr && it1.getNodePtr() != nullptr &&
-         *it1 == *it) {
-    ++it1;
+template <typename T, typename Compare, typename Allocator>
+template <typename K>
+typename multiset<T, Compare, Allocator>::size_type
+multiset<T, Compare, Allocator>::count_of(const K &key) {
+  auto range = equal_range_of(key);
+  size_type count = 0;
+  for (; range.first != range.second; ++range.first) {
     count++;
   }
   return count;
 }
 }  // namespace s21
 
-#endif
\ No newline at end of file
+#endif
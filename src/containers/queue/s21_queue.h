@@ -4,13 +4,17 @@
 #include "../list/s21_list.h"
 
 namespace s21 {
-template <typename T>
+// Container is any sequence with push_back, pop_front, front, back, size and
+// empty: s21::list by default. The allocator is chosen through it, e.g.
+// queue<T, s21::list<T, Alloc>>.
+template <typename T, typename Container = s21::list<T>>
 class queue {
  public:
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
+  using container_type = Container;
 
   queue() : data_(){};
   queue(std::initializer_list<value_type> const &items) : data_(items) {}
@@ -38,7 +42,7 @@ class queue {
   void swap(queue &q) { data_.swap(q.data_); }
 
  private:
-  s21::list<value_type> data_;
+  container_type data_;
 };
 }  // namespace s21
 
@@ -1,12 +1,100 @@
 #ifndef S21_BNTREE
 #define S21_BNTREE
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "s21_memory.h"
 
 namespace s21 {
+// Links of a tree node. The tree's header is a bare tree_node_base: its left
+// child is the root, and it is the position end() points at.
+struct tree_node_base {
+  explicit tree_node_base(tree_node_base* parent = nullptr)
+      : n_parent(parent) {}
+  // The two ints go first so the links sit right before the value and a
+  // traversal touches one contiguous run of each node.
+  int n_height = 1;
+  // Number of elements in the subtree rooted here; the header keeps 0.
+  int n_count = 0;
+  tree_node_base* n_parent;
+  tree_node_base* n_left = nullptr;
+  tree_node_base* n_right = nullptr;
+};
+
 template <typename Key, typename Value>
-class tree {
+struct tree_node : tree_node_base {
+  template <typename... Args>
+  tree_node(tree_node_base* parent, const Key& key, Args&&... args)
+      : tree_node_base(parent),
+        n_data(std::piecewise_construct, std::forward_as_tuple(key),
+               std::forward_as_tuple(std::forward<Args>(args)...)) {}
+  // Key and value live together so map iterators can hand out a reference
+  // to the stored pair instead of building one.
+  std::pair<const Key, Value> n_data;
+};
+
+// A pair of iterators usable in a range-for, as returned by range(lo, hi).
+// Nothing is copied: the elements are read from the container as the loop
+// advances, so erasing inside the window invalidates the view.
+template <typename It>
+class iterator_range {
+ public:
+  iterator_range(It first, It last) : r_first(first), r_last(last) {}
+  It begin() const { return r_first; }
+  It end() const { return r_last; }
+  bool empty() const { return !(It(r_first) != r_last); }
+
+ private:
+  It r_first;
+  It r_last;
+};
+
+// Holds a container's comparator. Like allocator_base, an empty comparator
+// such as std::less takes no space.
+template <typename Compare,
+          bool = std::is_empty_v<Compare> && !std::is_final_v<Compare>>
+class compare_base : private Compare {
+ protected:
+  compare_base() = default;
+  explicit compare_base(const Compare &comp) : Compare(comp) {}
+
+  Compare &comp() noexcept { return *this; }
+  const Compare &comp() const noexcept { return *this; }
+};
+
+template <typename Compare>
+class compare_base<Compare, false> {
+ protected:
+  compare_base() = default;
+  explicit compare_base(const Compare &comp) : comp_(comp) {}
+
+  Compare &comp() noexcept { return comp_; }
+  const Compare &comp() const noexcept { return comp_; }
+
+ private:
+  Compare comp_;
+};
+
+// Nodes live in a node_pool: slabs allocated through Allocator rebound to
+// tree_node<Key, Value>. Erased nodes are reused by later inserts; clear()
+// and destruction hand whole slabs back, and a copy fills a single slab.
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Value>>
+class tree : private allocator_base<typename std::allocator_traits<
+                 Allocator>::template rebind_alloc<tree_node<Key, Value>>>,
+             private compare_base<Compare> {
  protected:
-  struct Node;
+  using NodeBase = tree_node_base;
+  using Node = tree_node<Key, Value>;
+
+ private:
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
 
  public:
   class Iterator;
@@ -18,11 +106,13 @@ class tree {
   using iterator = Iterator;
   using const_iterator = ConstIterator;
   using size_type = size_t;
+  using allocator_type = Allocator;
+  using key_compare = Compare;
 
   class Iterator {
    public:
     Iterator();
-    Iterator(Node* node, Node* past_node = nullptr);
+    Iterator(NodeBase* node);
     iterator& operator++();
     iterator operator++(int);
     iterator& operator--();
@@ -31,13 +121,12 @@ class tree {
 
     bool operator==(const iterator& it);
     bool operator!=(const iterator& it);
-    friend class tree<Key, Value>;
+    friend class tree;
 
    protected:
-    Node* it_node;
-    Node* it_past_node;
-    Node* move_forward(Node* node);
-    Node* move_back(Node* node);
+    NodeBase* it_node;
+    static NodeBase* move_forward(NodeBase* node);
+    static NodeBase* move_back(NodeBase* node);
   };
   class ConstIterator : public Iterator {
    public:
@@ -46,31 +135,28 @@ class tree {
   };
   
   tree();
+  explicit tree(const Allocator& alloc);
+  explicit tree(const Compare& comp, const Allocator& alloc = Allocator());
   tree(const tree& other);
+  tree(const tree& other, const Allocator& alloc);
   tree(tree&& other);
   ~tree();
-  tree& operator=(tree&& other);
+  tree& operator=(tree&& other) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value);
   tree& operator=(const tree& other);
+  allocator_type get_allocator() const;
+  key_compare key_comp() const { return this->comp(); }
   iterator begin();
   iterator end();
   bool empty();
-  size_type size();
+  size_type size() const;
   size_type max_size();
   void clear();
   std::pair<iterator, bool> insert(key_type key);
   std::pair<iterator, bool> insert(const key_type& key, const value_type& value) {
-
-  std::pair<iterator, bool> return_value;
-  if (t_root == nullptr) {
-    Node* new_node = new Node(key, value);
-    t_root = new_node;
-    return_value.first = Iterator(t_root);
-    return_value.second = true;
-  } else {
-    return_value.second = recursive_insert(t_root, key, value);
-    return_value.first = find(key);
-  }
-  return return_value;
+    std::pair<Node*, bool> inserted = insert_node(key, value);
+    return {Iterator(inserted.first), inserted.second};
   }
 
   
@@ -78,505 +164,1091 @@ class tree {
   void swap(tree& other);
   void merge(tree& other);
   bool contains(const Key &key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) {
+    return find_node(key) != nullptr;
+  }
+  // Number of elements less than key, in O(log n).
+  size_type rank(const Key& key) const;
+  // Replace the contents with the union, intersection or difference of a
+  // and b by key; a's value is kept when both hold a key. a and b must not
+  // be *this. Each is one ordered walk plus a one-slab build, O(n + m);
+  // intersection and a difference with a much smaller a look keys up
+  // instead, in O(m log n).
+  void assign_union(const tree& a, const tree& b);
+  void assign_intersection(const tree& a, const tree& b);
+  void assign_difference(const tree& a, const tree& b);
 
  protected:
   iterator find(const Key &key);
-  struct Node {
-    Node(key_type key, value_type value);
-    Node(key_type key, value_type value, Node* parent);
-    key_type n_key = nullptr;
-    value_type n_value = nullptr;
-    Node* n_parent = nullptr;
-    int n_height = 1;
-    Node* n_left = nullptr;
-    Node* n_right = nullptr;
-    int n_count = 0;
-    friend class tree<Key, Value>;
-    friend class tree<Key, Value>::Iterator;
-  };
-  Node *t_root;
-  void free_node(Node* node);
-  Node* copy_tree(Node* node, Node* parent);
-  void swap_value(Node* a, Node* b);
-  void right_rotate(Node* node);
-  void left_rotate(Node* node);
-  void balance(Node* node);
-  int get_balance_factor(Node* node);
-  int get_height(Node* node);
-  void set_height(Node* node);
-  static Node* get_min(Node* node);
-  static Node* get_max(Node* node);
-
-  bool recursive_insert(Node* node, const Key& key, Value value);
-  Node* recursive_delete(Node* node, Key key);
-  size_t recursive_size(Node* node);
-  Node* recursive_find(Node* node, const Key& key);
+  NodeBase t_header;
+  size_type t_size;
+  node_pool<Node> m_pool;
+  template <typename... Args>
+  Node* create_node(Args&&... args);
+  void destroy_node(Node* node);
+  void free_node(NodeBase* node);
+  void swap_nodes(tree& other) noexcept;
+  Node* copy_tree(const Node* node, NodeBase* parent);
+  Node* root() const { return as_node(t_header.n_left); }
+  void set_root(NodeBase* node);
+  NodeBase* first_node() const;
+  static Node* as_node(NodeBase* node) { return static_cast<Node*>(node); }
+  void replace_child(NodeBase* parent, NodeBase* old_child,
+                     NodeBase* new_child);
+  NodeBase* right_rotate(NodeBase* node);
+  NodeBase* left_rotate(NodeBase* node);
+  NodeBase* balance(NodeBase* node);
+  void rebalance_up(NodeBase* node, int delta);
+  void erase_node(NodeBase* node);
+  int get_balance_factor(NodeBase* node);
+  int get_height(NodeBase* node);
+  static int get_count(const NodeBase* node);
+  void update_node(NodeBase* node);
+  NodeBase* select_node(size_type k) const;
+  static NodeBase* get_min(NodeBase* node);
+  static NodeBase* get_max(NodeBase* node);
+
+  template <typename... Args>
+  std::pair<Node*, bool> insert_node(const Key& key, Args&&... args);
+  Node* find_slot(const Key& key, NodeBase*& parent, NodeBase**& link);
+  void link_leaf(NodeBase* node, NodeBase* parent, NodeBase** link);
+  template <typename K>
+  Node* find_node(const K& key) const;
+  template <bool Upper, typename K>
+  NodeBase* descend(const K& key, NodeBase*& parent, NodeBase**& link) const;
+  template <typename K>
+  NodeBase* lower_bound_node(const K& key) const;
+  template <typename K>
+  NodeBase* upper_bound_node(const K& key) const;
+  template <typename K>
+  std::pair<NodeBase*, NodeBase*> equal_range_nodes(const K& key) const;
+  NodeBase* release_list();
+  NodeBase* relink_balanced(NodeBase*& next, size_type count,
+                            NodeBase* parent);
+  using node_list = std::vector<
+      const Node*,
+      typename std::allocator_traits<Allocator>::template rebind_alloc<
+          const Node*>>;
+  void build_from_nodes(const node_list& nodes);
+  static bool much_smaller(size_type small, size_type large);
+  template <typename InputIt, typename Project>
+  void assign_unique(InputIt first, InputIt last, Project project);
+  template <typename It, typename Project>
+  void build_from(It first, size_type count, Project project);
+  template <typename It, typename Project>
+  NodeBase* build_balanced(It& next, size_type count, NodeBase* parent,
+                           Project& project);
 };
 
-template <typename Key, typename Value>
-tree<Key, Value>::tree() : t_root(nullptr) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::tree() : t_size(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::tree(const Allocator& alloc)
+    : allocator_base<node_allocator>(node_allocator(alloc)), t_size(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::tree(const Compare& comp,
+                                           const Allocator& alloc)
+    : allocator_base<node_allocator>(node_allocator(alloc)),
+      compare_base<Compare>(comp),
+      t_size(0) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::tree(const tree& other)
+    : tree(other, node_traits::select_on_container_copy_construction(
+                      other.alloc())) {}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::tree(const tree& other,
+                                           const Allocator& alloc)
+    : tree(other.comp(), alloc) {
+  m_pool.reserve(this->alloc(), other.t_size);
+  try {
+    set_root(copy_tree(other.root(), &t_header));
+    t_size = other.t_size;
+  } catch (...) {
+    m_pool.release(this->alloc());
+    throw;
+  }
+}
 
-template <typename Key, typename Value>
-tree<Key, Value>::tree(const tree& other) {
-  t_root = copy_tree(other.t_root, nullptr);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::allocator_type
+tree<Key, Value, Compare, Allocator>::get_allocator() const {
+  return allocator_type(this->alloc());
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::copy_tree(
-    typename tree<Key, Value>::Node* node,
-    typename tree<Key, Value>::Node* parent) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename tree<Key, Value, Compare, Allocator>::Node*
+tree<Key, Value, Compare, Allocator>::create_node(Args&&... args) {
+  Node* node = m_pool.allocate(this->alloc());
+  try {
+    node_traits::construct(this->alloc(), node, std::forward<Args>(args)...);
+  } catch (...) {
+    m_pool.deallocate(node);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::destroy_node(Node* node) {
+  node_traits::destroy(this->alloc(), node);
+  m_pool.deallocate(node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::Node*
+tree<Key, Value, Compare, Allocator>::copy_tree(const Node* node,
+                                                NodeBase* parent) {
   if (node == nullptr) {
     return nullptr;
   }
-  Node *new_node = new Node(node->n_key, node->n_value, parent);
+  Node *new_node = create_node(parent, node->n_data.first, node->n_data.second);
   new_node->n_height = node->n_height;
-  new_node->n_left = copy_tree(node->n_left, new_node);
-  new_node->n_right = copy_tree(node->n_right, new_node);
+  new_node->n_count = node->n_count;
+  try {
+    new_node->n_left = copy_tree(as_node(node->n_left), new_node);
+    new_node->n_right = copy_tree(as_node(node->n_right), new_node);
+  } catch (...) {
+    free_node(new_node);
+    throw;
+  }
   return new_node;
 }
 
-template <typename Key, typename Value>
-tree<Key, Value>::tree(tree&& other) {
-  t_root = other.t_root;
-  other.t_root = nullptr;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::tree(tree&& other)
+    : allocator_base<node_allocator>(std::move(other.alloc())),
+      compare_base<Compare>(other.comp()),
+      m_pool(std::move(other.m_pool)) {
+  set_root(other.root());
+  t_size = other.t_size;
+  other.t_header.n_left = nullptr;
+  other.t_size = 0;
 }
 
-template <typename Key, typename Value>
-tree<Key, Value>::~tree() {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::~tree() {
   clear();
 }
 
-template <typename Key, typename Value>
-void tree<Key, Value>::clear() {
-  if (t_root != nullptr) {
-    free_node(t_root);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::clear() {
+  free_node(root());
+  t_header.n_left = nullptr;
+  t_size = 0;
+  m_pool.release(this->alloc());
+}
+
+// Runs the destructors of a subtree without returning its memory to the
+// pool; the caller frees the slabs as a whole.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::free_node(NodeBase* node) {
+  if constexpr (!trivially_destroyed<node_allocator, Node>) {
+    if (node == nullptr) {
+      return;
+    }
+    free_node(node->n_left);
+    free_node(node->n_right);
+    node_traits::destroy(this->alloc(), as_node(node));
   }
-  t_root = nullptr;
 }
 
-template <typename Key, typename Value>
-void tree<Key, Value>::free_node(typename tree<Key, Value>::Node* node) {
-  if (node == nullptr) {
-    return;
+// The root points back at the header it hangs from, so exchanging trees
+// re-parents both roots. The comparators travel with the elements.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::swap_nodes(tree& other) noexcept {
+  Node* other_root = other.root();
+  other.set_root(root());
+  set_root(other_root);
+  std::swap(t_size, other.t_size);
+  m_pool.swap(other.m_pool);
+  using std::swap;
+  swap(this->comp(), other.comp());
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::set_root(NodeBase* node) {
+  t_header.n_left = node;
+  if (node != nullptr) {
+    node->n_parent = &t_header;
   }
-  free_node(node->n_left);
-  free_node(node->n_right);
-  delete node;
 }
 
-template <typename Key, typename Value>
-tree<Key, Value>::Iterator::Iterator()
-    : it_node(nullptr), it_past_node(nullptr) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::Iterator::Iterator() : it_node(nullptr) {}
 
-template <typename Key, typename Value>
-tree<Key, Value>::Iterator::Iterator(tree<Key, Value>::Node* node, tree<Key, Value>::Node* past_node)
-    : it_node(node), it_past_node(past_node) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>::Iterator::Iterator(NodeBase* node)
+    : it_node(node) {}
 
-template <typename Key, typename Value>
-tree<Key, Value>& tree<Key, Value>::operator=(const tree& other) {
-  if (this != other) {
-    Node* temp(other);
-    free_node(t_root);
-    t_root = std::move(temp);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>&
+tree<Key, Value, Compare, Allocator>::operator=(const tree& other) {
+  if (this != &other) {
+    if constexpr (node_traits::propagate_on_container_copy_assignment::value) {
+      if (this->alloc() != other.alloc()) {
+        clear();
+      }
+    }
+    propagate_on_copy(this->alloc(), other.alloc());
+    tree copy(other, allocator_type(this->alloc()));
+    swap_nodes(copy);
   }
+  return *this;
 }
 
-template <typename Key, typename Value>
-tree<Key, Value>& tree<Key, Value>::operator=(tree&& other) {
-  if (this != other) {
-    t_root = other.t_root;
-    other.t_root = nullptr;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+tree<Key, Value, Compare, Allocator>&
+tree<Key, Value, Compare, Allocator>::operator=(tree&& other) noexcept(
+    node_traits::propagate_on_container_move_assignment::value ||
+    node_traits::is_always_equal::value) {
+  if (this != &other) {
+    clear();
+    if (can_steal_on_move(this->alloc(), other.alloc())) {
+      propagate_on_move(this->alloc(), other.alloc());
+      swap_nodes(other);
+    } else {
+      tree copy(other, allocator_type(this->alloc()));
+      swap_nodes(copy);
+      other.clear();
+    }
   }
+  return *this;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator tree<Key, Value>::begin() {
-  return tree::Iterator(get_min(t_root));
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator
+tree<Key, Value, Compare, Allocator>::begin() {
+  return tree::Iterator(first_node());
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator tree<Key, Value>::end() {
-  if (t_root == nullptr) return nullptr;
-  Node* last_node = get_max(t_root);
-  iterator res(nullptr, last_node);
-  return res;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator
+tree<Key, Value, Compare, Allocator>::end() {
+  return tree::Iterator(&t_header);
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator &tree<Key, Value>::Iterator::operator++() {
-  Node* temp;
-  if (it_node != nullptr) {
-    temp = get_max(it_node);
-  }
+// The leftmost node, or the header when the tree is empty. Const so the
+// set operations can walk their const operands; the header itself is
+// never written through the result.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::first_node() const {
+  return t_header.n_left == nullptr ? const_cast<NodeBase*>(&t_header)
+                                    : get_min(t_header.n_left);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator&
+tree<Key, Value, Compare, Allocator>::Iterator::operator++() {
   it_node = move_forward(it_node);
-  if (it_node == nullptr) {
-    it_past_node = temp;
-  }
   return *this;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator tree<Key, Value>::Iterator::operator++(
-    int) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator
+tree<Key, Value, Compare, Allocator>::Iterator::operator++(int) {
   Iterator temp = *this;
   operator++();
   return temp;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator &tree<Key, Value>::Iterator::operator--() {
-  if (it_node == nullptr && it_past_node != nullptr) {
-    *this = it_past_node;  //// ????????
-    return *this;
-  }
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator&
+tree<Key, Value, Compare, Allocator>::Iterator::operator--() {
   it_node = move_back(it_node);
   return *this;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator tree<Key, Value>::Iterator::operator--(
-    int) {
-  Node* temp = *this;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator
+tree<Key, Value, Compare, Allocator>::Iterator::operator--(int) {
+  Iterator temp = *this;
   operator--();
   return temp;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::reference tree<Key, Value>::Iterator::operator*() {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::reference
+tree<Key, Value, Compare, Allocator>::Iterator::operator*() {
   if (it_node == nullptr) {
     static Value fake_val{};
     return fake_val;
   }
-  return it_node->n_value;
+  return as_node(it_node)->n_data.second;
 }
 
 // template <typename Key, typename Value>
 // std::pair<Key, typename tree<Key, Value>::reference> tree<Key, Value>::Iterator::operator*() {
 //   std::pair<Key, reference> return_value;
-//   return_value.first = it_node->n_key;
-//   return_value.second = it_node->n_value;
+//   return_value.first = it_node->n_data.first;
+//   return_value.second = it_node->n_data.second;
 // }
 
-template <typename Key, typename Value>
-bool tree<Key, Value>::Iterator::operator==(
-    const tree<Key, Value>::iterator& it) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool tree<Key, Value, Compare, Allocator>::Iterator::operator==(
+    const tree<Key, Value, Compare, Allocator>::iterator& it) {
   return it_node == it.it_node;
 }
 
-template <typename Key, typename Value>
-bool tree<Key, Value>::Iterator::operator!=(
-    const tree<Key, Value>::iterator& it) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool tree<Key, Value, Compare, Allocator>::Iterator::operator!=(
+    const tree<Key, Value, Compare, Allocator>::iterator& it) {
   return it_node != it.it_node;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::get_min(
-    typename tree<Key, Value>::Node* node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::get_min(NodeBase* node) {
   if (node == nullptr) {
     return nullptr;
   }
-  if (node->n_left == nullptr) {
-    return node;
+  while (node->n_left != nullptr) {
+    node = node->n_left;
   }
-  return get_min(node->n_left);
-
+  return node;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::get_max(
-    typename tree<Key, Value>::Node* node) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::get_max(NodeBase* node) {
   if (node == nullptr) {
     return nullptr;
   }
-  if (node->n_right == nullptr) {
-    return node;
+  while (node->n_right != nullptr) {
+    node = node->n_right;
   }
-  return get_max(node->n_right);
+  return node;
 }
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::Iterator::move_forward(
-    typename tree<Key, Value>::Node* node) {
-  if(node == nullptr){
-    return nullptr;
-  }
+
+// In-order successor. The root is the header's left child and the header
+// has no right child, so climbing past the maximum stops at the header,
+// which is end(). Each link is crossed at most twice over a full traversal.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::Iterator::move_forward(NodeBase* node) {
   if (node->n_right != nullptr) {
     return get_min(node->n_right);
   }
-  Node* parent = node->n_parent;
-  while (parent != nullptr && parent->n_right == node) {
+  NodeBase* parent = node->n_parent;
+  while (parent->n_right == node) {
     node = parent;
     parent = parent->n_parent;
   }
   return parent;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::Iterator::move_back(
-    typename tree<Key, Value>::Node* node) {
+// In-order predecessor; from the header it descends to the maximum, which
+// is what --end() needs.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::Iterator::move_back(NodeBase* node) {
   if (node->n_left != nullptr) {
     return get_max(node->n_left);
   }
-  Node* parent = node->n_parent;
-  while (parent != nullptr && parent->n_left == node) {
+  NodeBase* parent = node->n_parent;
+  while (parent->n_left == node) {
     node = parent;
     parent = parent->n_parent;
   }
   return parent;
 }
 
-template <typename Key, typename Value>
-bool tree<Key, Value>::empty() {
-  return (t_root == nullptr);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool tree<Key, Value, Compare, Allocator>::empty() {
+  return t_size == 0;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::size_type tree<Key, Value>::size() {
-  return recursive_size(t_root);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::size_type
+tree<Key, Value, Compare, Allocator>::size() const {
+  return t_size;
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::size_type tree<Key, Value>::max_size() {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::size_type
+tree<Key, Value, Compare, Allocator>::max_size() {
   return std::numeric_limits<size_type>::max() /
-         sizeof(typename tree<Key, Value>::Node);
+         sizeof(typename tree<Key, Value, Compare, Allocator>::Node);
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::size_type tree<Key, Value>::recursive_size(
-    tree<Key, Value>::Node* node) {
-  if (node == nullptr) return 0;
-  size_type left_size = recursive_size(node->n_left);
-  size_type right_size = recursive_size(node->n_right);
-  return 1 + left_size + right_size;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+int tree<Key, Value, Compare, Allocator>::get_height(NodeBase* node) {
+  return node == nullptr ? 0 : node->n_height;
 }
 
-template <typename Key, typename Value>
-tree<Key, Value>::Node::Node(tree<Key, Value>::key_type key, tree<Key, Value>::value_type value)
-    : n_key(key), n_value(value), n_height(1) {}
-
-template <typename Key, typename Value>
-tree<Key, Value>::Node::Node(key_type key, value_type value, Node* parent)
-    : n_key(key), n_value(value), n_parent(parent), n_height(1) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+int tree<Key, Value, Compare, Allocator>::get_balance_factor(NodeBase* node) {
+  return node == nullptr ? 0
+                         : get_height(node->n_right) - get_height(node->n_left);
+}
 
-template <typename Key, typename Value>
-void tree<Key, Value>::swap_value(tree<Key, Value>::Node* a,
-                                  tree<Key, Value>::Node* b) {
-  std::swap(a->n_value, b->n_value);
-  std::swap(a->n_key, b->n_key);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename tree<Key, Value, Compare, Allocator>::iterator, bool>
+tree<Key, Value, Compare, Allocator>::insert(key_type key) {
+  std::pair<Node*, bool> inserted = insert_node(key, key);
+  return {Iterator(inserted.first), inserted.second};
 }
 
-template <typename Key, typename Value>
-int tree<Key, Value>::get_height(tree<Key, Value>::Node* node) {
-  return node == nullptr ? 0 : node->n_height;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::iterator
+tree<Key, Value, Compare, Allocator>::find(const Key& key) {
+  Node* node = find_node(key);
+  return node == nullptr ? end() : Iterator(node);
 }
 
-template <typename Key, typename Value>
-int tree<Key, Value>::get_balance_factor(tree<Key, Value>::Node* node) {
-  return node == nullptr ? 0
-                         : get_height(node->n_right) - get_height(node->n_left);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename tree<Key, Value, Compare, Allocator>::Node*
+tree<Key, Value, Compare, Allocator>::find_node(const K& key) const {
+  NodeBase* bound = lower_bound_node(key);
+  if (bound == &t_header || this->comp()(key, as_node(bound)->n_data.first)) {
+    return nullptr;
+  }
+  return as_node(bound);
 }
 
-template <typename Key, typename Value>
-std::pair<typename tree<Key, Value>::iterator, bool> tree<Key, Value>::insert(
-    tree<Key, Value>::key_type key) {
-
-  std::pair<iterator, bool> return_value;
-  if (t_root == nullptr) {
-    Node* new_node = new Node(key, key);
-    t_root = new_node;
-    return_value.first = Iterator(t_root);
-    return_value.second = true;
-  } else {
-    return_value.second = recursive_insert(t_root, key, key);
-    return_value.first = find(key);
+// Walks from the root down to the empty child slot where key belongs,
+// passing to the right of nodes ordered before key (with Upper: not after
+// key). Each level makes one comparator call and steps with a select on its
+// result; keeping a running bound or testing for equality on the way down
+// costs the loop its cmov and made lookups two to three times slower.
+// Returns the first node after the slot in key order, or the header: the
+// slot's parent, or its successor when the slot is a right child.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <bool Upper, typename K>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::descend(const K& key, NodeBase*& parent,
+                                              NodeBase**& link) const {
+  NodeBase* last = const_cast<NodeBase*>(&t_header);
+  NodeBase* node = t_header.n_left;
+  bool right = false;
+  while (node != nullptr) {
+    last = node;
+    const Key& node_key = as_node(node)->n_data.first;
+    right = Upper ? !this->comp()(key, node_key) : this->comp()(node_key, key);
+    node = right ? node->n_right : node->n_left;
   }
-  return return_value;
+  parent = last;
+  link = right ? &last->n_right : &last->n_left;
+  return right ? Iterator::move_forward(last) : last;
 }
 
-// template <typename Key, typename Value>
-// std::pair<typename tree<Key, Value>::iterator, bool> tree<Key, Value>::insert(const 
-  //   Key& key, const Value& value) {
-
-  // std::pair<iterator, bool> return_value;
-  // if (t_root == nullptr) {
-  //   Node* new_node = new Node(key, value);
-  //   t_root = new_node;
-  //   return_value.first = Iterator(t_root);
-  //   return_value.second = true;
-  // } else {
-  //   return_value.second = recursive_insert(t_root, key, value);
-  //   return_value.first = find(key);
-  // }
-  // return return_value;
-// }
+// The first node whose key is not less than key, or the header.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::lower_bound_node(const K& key) const {
+  NodeBase* parent;
+  NodeBase** link;
+  return descend<false>(key, parent, link);
+}
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::iterator tree<Key, Value>::find(const Key& key) {
-  Node* search_node = recursive_find(t_root, key);
-  return Iterator(search_node);
+// The first node whose key is greater than key, or the header.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::upper_bound_node(const K& key) const {
+  NodeBase* parent;
+  NodeBase** link;
+  return descend<true>(key, parent, link);
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::recursive_find(
-    tree<Key, Value>::Node* node, const Key& key) {
-  if (node == nullptr || key == node->n_key) return node;
-  if (key > node->n_key) {
-    return recursive_find(node->n_right, key);
+// Keys are unique, so the upper bound is the lower bound or its successor
+// and one descent is enough.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K>
+std::pair<typename tree<Key, Value, Compare, Allocator>::NodeBase*,
+          typename tree<Key, Value, Compare, Allocator>::NodeBase*>
+tree<Key, Value, Compare, Allocator>::equal_range_nodes(const K& key) const {
+  NodeBase* first = lower_bound_node(key);
+  NodeBase* last = first;
+  if (last != &t_header && !this->comp()(key, as_node(last)->n_data.first)) {
+    last = Iterator::move_forward(last);
+  }
+  return {first, last};
+}
+
+// One descent from the root: returns the node holding key, or links a new
+// leaf under the last node visited and rebalances upwards from there. args
+// construct the value and are left untouched when key is already present.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename tree<Key, Value, Compare, Allocator>::Node*, bool>
+tree<Key, Value, Compare, Allocator>::insert_node(const Key& key,
+                                                  Args&&... args) {
+  NodeBase* parent;
+  NodeBase** link;
+  if (Node* existing = find_slot(key, parent, link)) {
+    return {existing, false};
   }
-  else {
-    return recursive_find(node->n_left, key);
+  Node* node = create_node(parent, key, std::forward<Args>(args)...);
+  link_leaf(node, parent, link);
+  return {node, true};
+}
+
+// Returns the node holding key, or null with parent and link set to the
+// empty child slot where key belongs. When key is absent its slot lies
+// right before its lower bound, so one descent serves both cases.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::Node*
+tree<Key, Value, Compare, Allocator>::find_slot(const Key& key,
+                                                NodeBase*& parent,
+                                                NodeBase**& link) {
+  NodeBase* bound = descend<false>(key, parent, link);
+  if (bound == &t_header || this->comp()(key, as_node(bound)->n_data.first)) {
+    return nullptr;
   }
+  return as_node(bound);
 }
 
-template <typename Key, typename Value>
-bool tree<Key, Value>::recursive_insert(tree<Key, Value>::Node* node,
-                                        const Key& key, Value value) {
-  bool res = false;
-  if (key < node->n_key) {
-    if (node->n_left == nullptr) {
-      node->n_left = new Node(key, value, node);
-      res = true;
-    } else {
-      res = recursive_insert(node->n_left, key, value);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::link_leaf(NodeBase* node,
+                                                     NodeBase* parent,
+                                                     NodeBase** link) {
+  node->n_parent = parent;
+  node->n_left = node->n_right = nullptr;
+  node->n_height = 1;
+  node->n_count = 1;
+  *link = node;
+  t_size++;
+  rebalance_up(parent, 1);
+}
+
+// Replaces the contents with [first, last), keeping the first of equal keys
+// as repeated insert() would. project(element) yields a pair of references
+// to the key and the value. A forward range that is already sorted and free
+// of duplicates is built straight into a balanced tree; any other forward
+// range is ordered through a vector of iterators first, so the elements
+// themselves are never copied.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename Project>
+void tree<Key, Value, Compare, Allocator>::assign_unique(InputIt first,
+                                                         InputIt last,
+                                                         Project project) {
+  clear();
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+    size_type count = 0;
+    bool sorted = true;
+    for (InputIt it = first, prev = first; it != last; prev = it, ++it) {
+      if (count++ > 0 &&
+          !this->comp()(project(*prev).first, project(*it).first)) {
+        sorted = false;
+      }
+    }
+    if (sorted) {
+      build_from(first, count, project);
+      return;
+    }
+    using order_allocator = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<InputIt>;
+    std::vector<InputIt, order_allocator> order{
+        order_allocator(this->alloc())};
+    order.reserve(count);
+    for (; first != last; ++first) {
+      order.push_back(first);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](InputIt a, InputIt b) {
+      return this->comp()(project(*a).first, project(*b).first);
+    });
+    order.erase(std::unique(order.begin(), order.end(),
+                            [&](InputIt a, InputIt b) {
+                              return !this->comp()(project(*a).first,
+                                                   project(*b).first);
+                            }),
+                order.end());
+    build_from(order.begin(), order.size(),
+               [&](InputIt it) { return project(*it); });
+  } else {
+    for (; first != last; ++first) {
+      insert_node(project(*first).first, project(*first).second);
     }
   }
-  if (key > node->n_key) {
-    if (node->n_right == nullptr) {
-      node->n_right = new Node(key, value, node);
-      res = true;
+}
+
+// Builds count nodes from a sorted, duplicate-free sequence into one
+// reserved slab. The tree must be empty.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename It, typename Project>
+void tree<Key, Value, Compare, Allocator>::build_from(It first, size_type count,
+                                                      Project project) {
+  m_pool.reserve(this->alloc(), count);
+  try {
+    set_root(build_balanced(first, count, &t_header, project));
+  } catch (...) {
+    clear();
+    throw;
+  }
+  t_size = count;
+}
+
+// Builds the next count elements into a perfectly balanced subtree: the
+// left half, then the middle element, then the right half, so elements are
+// consumed in order. On failure the part already built is destroyed.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename It, typename Project>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::build_balanced(It& next, size_type count,
+                                                     NodeBase* parent,
+                                                     Project& project) {
+  if (count == 0) {
+    return nullptr;
+  }
+  size_type left_count = count / 2;
+  NodeBase* left = build_balanced(next, left_count, nullptr, project);
+  Node* node;
+  try {
+    node = create_node(parent, project(*next).first, project(*next).second);
+  } catch (...) {
+    free_node(left);
+    throw;
+  }
+  ++next;
+  node->n_left = left;
+  if (left != nullptr) {
+    left->n_parent = node;
+  }
+  try {
+    node->n_right =
+        build_balanced(next, count - left_count - 1, node, project);
+  } catch (...) {
+    free_node(node);
+    throw;
+  }
+  update_node(node);
+  return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::erase(iterator pos) {
+  if (pos.it_node == nullptr || pos.it_node == &t_header) return;
+  erase_node(pos.it_node);
+}
+
+// Unlinks node and frees it. A node with two children is replaced by its
+// in-order successor, which is moved by relinking, so no element changes
+// nodes and iterators to other elements stay valid.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::erase_node(NodeBase* node) {
+  NodeBase* rebalance_from;
+  if (node->n_left != nullptr && node->n_right != nullptr) {
+    NodeBase* successor = get_min(node->n_right);
+    if (successor->n_parent != node) {
+      rebalance_from = successor->n_parent;
+      replace_child(successor->n_parent, successor, successor->n_right);
+      successor->n_right = node->n_right;
+      successor->n_right->n_parent = successor;
     } else {
-      res = recursive_insert(node->n_right, key, value);
+      rebalance_from = successor;
     }
+    successor->n_left = node->n_left;
+    successor->n_left->n_parent = successor;
+    successor->n_height = node->n_height;
+    successor->n_count = node->n_count;
+    replace_child(node->n_parent, node, successor);
+  } else {
+    rebalance_from = node->n_parent;
+    replace_child(node->n_parent, node,
+                  node->n_left != nullptr ? node->n_left : node->n_right);
   }
-  if (key == node->n_key) {
-    return res;
-  }
-  set_height(node);
-  balance(node);
-  return res;
+  destroy_node(as_node(node));
+  t_size--;
+  rebalance_up(rebalance_from, -1);
 }
 
-template <typename Key, typename Value>
-void tree<Key, Value>::erase(tree<Key, Value>::iterator pos) {
-  if(pos.it_node ==  nullptr) return;
-  t_root = recursive_delete(t_root, *pos);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::swap(
+    tree<Key, Value, Compare, Allocator> &other){
+    propagate_on_swap(this->alloc(), other.alloc());
+    swap_nodes(other);
 }
 
-template <typename Key, typename Value>
-typename tree<Key, Value>::Node* tree<Key, Value>::recursive_delete(
-    tree<Key, Value>::Node* node, Key key) {
-  if (node == nullptr) return nullptr;
-  if (key < node->n_key) {
-      node->n_left = recursive_delete(node->n_left, key);
-  }
-  if (key > node->n_key) {
-      node->n_right = recursive_delete(node->n_right, key);
-  }
-  if (key == node->n_key) {
-    if (node->n_left == nullptr || node->n_right == nullptr) {
-      Node* right = node->n_right;
-      Node* left = node->n_left;
-      Node* parent = node->n_parent;
-      delete node;
-      if (right == nullptr) {
-        node = left;
+// Moves every element of other into this tree and leaves other empty; a
+// key already present here keeps its value and other's node is destroyed.
+// With equal allocators no element is copied: this pool adopts other's
+// slabs and the nodes are relinked, either one descent each when other is
+// much smaller, or by flattening both trees into sorted lists, merging
+// them and rebuilding a balanced tree in O(n + m).
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::merge(
+    tree<Key, Value, Compare, Allocator> &other){
+  if (this == &other || other.t_size == 0) {
+    return;
+  }
+  if (this->alloc() != other.alloc()) {
+    for (NodeBase* node = other.first_node(); node != &other.t_header;
+         node = Iterator::move_forward(node)) {
+      insert_node(as_node(node)->n_data.first, as_node(node)->n_data.second);
+    }
+    other.clear();
+    return;
+  }
+  m_pool.adopt(this->alloc(), other.m_pool);
+  size_type other_size = other.t_size;
+  NodeBase* theirs = other.release_list();
+  if (much_smaller(other_size, t_size)) {
+    while (theirs != nullptr) {
+      NodeBase* next = theirs->n_right;
+      NodeBase* parent;
+      NodeBase** link;
+      if (find_slot(as_node(theirs)->n_data.first, parent, link) != nullptr) {
+        destroy_node(as_node(theirs));
+      } else {
+        link_leaf(theirs, parent, link);
       }
-      if (left == nullptr) {
-        node = right;
+      theirs = next;
+    }
+    return;
+  }
+  size_type count = t_size + other_size;
+  NodeBase* mine = release_list();
+  NodeBase head;
+  NodeBase* tail = &head;
+  while (mine != nullptr && theirs != nullptr) {
+    const Key& their_key = as_node(theirs)->n_data.first;
+    const Key& my_key = as_node(mine)->n_data.first;
+    if (this->comp()(their_key, my_key)) {
+      tail = tail->n_right = theirs;
+      theirs = theirs->n_right;
+    } else {
+      if (!this->comp()(my_key, their_key)) {
+        NodeBase* duplicate = theirs;
+        theirs = theirs->n_right;
+        destroy_node(as_node(duplicate));
+        count--;
       }
-      if (node != nullptr) node->n_parent = parent;
+      tail = tail->n_right = mine;
+      mine = mine->n_right;
+    }
+  }
+  tail->n_right = mine != nullptr ? mine : theirs;
+  NodeBase* next = head.n_right;
+  set_root(relink_balanced(next, count, &t_header));
+  t_size = count;
+}
+
+// Unhooks all nodes and returns them in key order, chained through
+// n_right. Left children are rotated up one at a time (tree-to-vine), so
+// this is O(n) with no extra memory. The nodes stay in the pool.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::release_list() {
+  NodeBase head;
+  head.n_right = root();
+  NodeBase* tail = &head;
+  NodeBase* rest = head.n_right;
+  while (rest != nullptr) {
+    if (rest->n_left == nullptr) {
+      tail = rest;
+      rest = rest->n_right;
     } else {
-      Node* min = get_min(node->n_right);
-      node->n_key = min->n_key;
-      node->n_value = min->n_value;
-      node->n_right = recursive_delete(node->n_right, min->n_key);
+      NodeBase* left = rest->n_left;
+      rest->n_left = left->n_right;
+      left->n_right = rest;
+      rest = left;
+      tail->n_right = left;
     }
   }
-  if (node != nullptr) {
-    set_height(node);
-    balance(node);
+  t_header.n_left = nullptr;
+  t_size = 0;
+  return head.n_right;
+}
+
+// Same shape as build_balanced(), but reuses the count nodes of a sorted
+// list chained through n_right.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::relink_balanced(NodeBase*& next,
+                                                      size_type count,
+                                                      NodeBase* parent) {
+  if (count == 0) {
+    return nullptr;
+  }
+  size_type left_count = count / 2;
+  NodeBase* left = relink_balanced(next, left_count, nullptr);
+  NodeBase* node = next;
+  next = next->n_right;
+  node->n_parent = parent;
+  node->n_left = left;
+  if (left != nullptr) {
+    left->n_parent = node;
   }
+  node->n_right = relink_balanced(next, count - left_count - 1, node);
+  update_node(node);
   return node;
 }
 
+// True when small lookups of O(log large) each beat a linear pass over
+// both trees.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool tree<Key, Value, Compare, Allocator>::much_smaller(size_type small,
+                                                        size_type large) {
+  size_type depth = 1;
+  for (size_type n = large; n > 1; n >>= 1) {
+    depth++;
+  }
+  return small * depth < small + large;
+}
 
-template <typename Key, typename Value>
-void tree<Key, Value>::swap(tree<Key, Value> &other){
-    std::swap(t_root, other.t_root);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::build_from_nodes(
+    const node_list& nodes) {
+  clear();
+  build_from(nodes.begin(), nodes.size(), [](const Node* node) {
+    return std::pair<const Key&, const Value&>(node->n_data.first,
+                                               node->n_data.second);
+  });
 }
 
-template <typename Key, typename Value>
-void tree<Key, Value>::merge(tree<Key, Value> &other){
-    tree const_other(other);
-    iterator it_const = const_other.begin();
-    for(;it_const != const_other.end(); it_const++){
-        insert(*it_const);
-        other.erase(it_const);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::assign_union(const tree& a,
+                                                        const tree& b) {
+  node_list nodes{typename node_list::allocator_type(this->alloc())};
+  nodes.reserve(a.t_size + b.t_size);
+  NodeBase* x = a.first_node();
+  NodeBase* y = b.first_node();
+  while (x != &a.t_header && y != &b.t_header) {
+    const Key& x_key = as_node(x)->n_data.first;
+    const Key& y_key = as_node(y)->n_data.first;
+    if (this->comp()(y_key, x_key)) {
+      nodes.push_back(as_node(y));
+      y = Iterator::move_forward(y);
+    } else {
+      if (!this->comp()(x_key, y_key)) {
+        y = Iterator::move_forward(y);
+      }
+      nodes.push_back(as_node(x));
+      x = Iterator::move_forward(x);
     }
-
+  }
+  for (; x != &a.t_header; x = Iterator::move_forward(x)) {
+    nodes.push_back(as_node(x));
+  }
+  for (; y != &b.t_header; y = Iterator::move_forward(y)) {
+    nodes.push_back(as_node(y));
+  }
+  build_from_nodes(nodes);
 }
 
-template <typename Key, typename Value>
-bool tree<Key, Value>::contains(const Key &key){
-    return find(key) != nullptr;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::assign_intersection(
+    const tree& a, const tree& b) {
+  node_list nodes{typename node_list::allocator_type(this->alloc())};
+  nodes.reserve(std::min(a.t_size, b.t_size));
+  if (much_smaller(a.t_size, b.t_size) || much_smaller(b.t_size, a.t_size)) {
+    bool a_smaller = a.t_size < b.t_size;
+    const tree& small = a_smaller ? a : b;
+    const tree& large = a_smaller ? b : a;
+    for (NodeBase* x = small.first_node(); x != &small.t_header;
+         x = Iterator::move_forward(x)) {
+      Node* match = large.find_node(as_node(x)->n_data.first);
+      if (match != nullptr) {
+        nodes.push_back(a_smaller ? as_node(x) : match);
+      }
+    }
+  } else {
+    NodeBase* x = a.first_node();
+    NodeBase* y = b.first_node();
+    while (x != &a.t_header && y != &b.t_header) {
+      const Key& x_key = as_node(x)->n_data.first;
+      const Key& y_key = as_node(y)->n_data.first;
+      if (this->comp()(x_key, y_key)) {
+        x = Iterator::move_forward(x);
+      } else if (this->comp()(y_key, x_key)) {
+        y = Iterator::move_forward(y);
+      } else {
+        nodes.push_back(as_node(x));
+        x = Iterator::move_forward(x);
+        y = Iterator::move_forward(y);
+      }
+    }
+  }
+  build_from_nodes(nodes);
 }
 
-template <typename Key, typename Value>
-void tree<Key, Value>::set_height(tree<Key, Value>::Node *node) {
-  node->n_height = get_height(node->n_left) +  get_height(node->n_right) +
-                  1;  
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::assign_difference(
+    const tree& a, const tree& b) {
+  node_list nodes{typename node_list::allocator_type(this->alloc())};
+  nodes.reserve(a.t_size);
+  NodeBase* x = a.first_node();
+  if (much_smaller(a.t_size, b.t_size)) {
+    for (; x != &a.t_header; x = Iterator::move_forward(x)) {
+      if (b.find_node(as_node(x)->n_data.first) == nullptr) {
+        nodes.push_back(as_node(x));
+      }
+    }
+  } else {
+    NodeBase* y = b.first_node();
+    while (x != &a.t_header) {
+      const Key& x_key = as_node(x)->n_data.first;
+      if (y == &b.t_header || this->comp()(x_key, as_node(y)->n_data.first)) {
+        nodes.push_back(as_node(x));
+        x = Iterator::move_forward(x);
+      } else {
+        if (!this->comp()(as_node(y)->n_data.first, x_key)) {
+          x = Iterator::move_forward(x);
+        }
+        y = Iterator::move_forward(y);
+      }
+    }
+  }
+  build_from_nodes(nodes);
 }
 
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool tree<Key, Value, Compare, Allocator>::contains(const Key &key){
+    return find_node(key) != nullptr;
+}
 
-template <typename Key, typename Value>
-void tree<Key, Value>::balance(tree<Key, Value>::Node* node){
-    int balance_fac = get_balance_factor(node);
-    if(balance_fac < -1){
-        right_rotate(node);
-    }if(balance_fac > 1){
-        left_rotate(node);
-    }
+template <typename Key, typename Value, typename Compare, typename Allocator>
+int tree<Key, Value, Compare, Allocator>::get_count(const NodeBase* node) {
+  return node == nullptr ? 0 : node->n_count;
 }
 
+// Recomputes the height and size of node from its children.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::update_node(NodeBase *node) {
+  node->n_height =
+      std::max(get_height(node->n_left), get_height(node->n_right)) + 1;
+  node->n_count = get_count(node->n_left) + get_count(node->n_right) + 1;
+}
 
-template <typename Key, typename Value>
-void tree<Key, Value>::right_rotate(tree<Key, Value>::Node* node){
-    Node *right = node->n_right;
-    swap_value(node, node->n_left);
-    node->n_right = node->n_left;
-    
-    node->n_left = node->n_right->n_left;
-    if(node->n_left){
-        node->n_left->n_parent = node;
+// Returns the node at in-order position k, or the header when k is out of
+// range, by descending on subtree sizes.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::select_node(size_type k) const {
+  if (k >= t_size) {
+    return const_cast<NodeBase*>(&t_header);
+  }
+  NodeBase* node = t_header.n_left;
+  for (;;) {
+    size_type left = get_count(node->n_left);
+    if (k == left) {
+      return node;
     }
-    node->n_right->n_left = node->n_right->n_right;
-    node->n_right->n_right = right;
-    if(node->n_right->n_right){
-        node->n_right->n_right->n_parent = node->n_right;
+    if (k < left) {
+      node = node->n_left;
+    } else {
+      k -= left + 1;
+      node = node->n_right;
     }
-    set_height(node->n_right);
-    set_height(node);
-
+  }
 }
 
-template <typename Key, typename Value>
-void tree<Key, Value>::left_rotate(tree<Key, Value>::Node* node){
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::size_type
+tree<Key, Value, Compare, Allocator>::rank(const Key& key) const {
+  size_type less = 0;
+  NodeBase* node = t_header.n_left;
+  while (node != nullptr) {
+    if (this->comp()(as_node(node)->n_data.first, key)) {
+      less += get_count(node->n_left) + 1;
+      node = node->n_right;
+    } else {
+      node = node->n_left;
+    }
+  }
+  return less;
+}
 
-    Node *left = node->n_left;
-    swap_value(node, node->n_right);
-    node->n_left = node->n_right;
 
-    node->n_right = node->n_left->n_right;
-    if(node->n_right){
-        node->n_right->n_parent = node;
+// Restores the AVL invariant at node with one or two rotations and returns
+// the root of the subtree.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::balance(NodeBase* node) {
+  int balance_fac = get_balance_factor(node);
+  if (balance_fac < -1) {
+    if (get_balance_factor(node->n_left) > 0) {
+      left_rotate(node->n_left);
     }
-    node->n_left->n_right = node->n_left->n_left;
-    node->n_left->n_left = left;
-    if(node->n_left->n_left){
-        node->n_left->n_left->n_parent = node->n_left;
+    return right_rotate(node);
+  }
+  if (balance_fac > 1) {
+    if (get_balance_factor(node->n_right) < 0) {
+      right_rotate(node->n_right);
     }
-    set_height(node->n_left);
-    set_height(node);
+    return left_rotate(node);
+  }
+  return node;
+}
 
+// Fixes heights, sizes and balance from node up to the root after the
+// subtree below node gained or lost delta elements. Ancestors only see a
+// subtree's shape through its height, so once a subtree comes out of
+// rebalancing as tall as it was before, the rest of the walk just adds
+// delta to the sizes.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::rebalance_up(NodeBase* node,
+                                                        int delta) {
+  while (node != &t_header) {
+    int old_height = node->n_height;
+    update_node(node);
+    node = balance(node);
+    bool same_height = node->n_height == old_height;
+    node = node->n_parent;
+    if (same_height) break;
+  }
+  for (; node != &t_header; node = node->n_parent) {
+    node->n_count += delta;
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void tree<Key, Value, Compare, Allocator>::replace_child(NodeBase* parent,
+                                                         NodeBase* old_child,
+                                                         NodeBase* new_child) {
+  if (parent->n_left == old_child) {
+    parent->n_left = new_child;
+  } else {
+    parent->n_right = new_child;
+  }
+  if (new_child != nullptr) {
+    new_child->n_parent = parent;
+  }
+}
+
+// Rotations only rewire links: the left child takes node's place and node
+// becomes its right child. Returns the new subtree root.
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::right_rotate(NodeBase* node) {
+  NodeBase* left = node->n_left;
+  node->n_left = left->n_right;
+  if (node->n_left != nullptr) {
+    node->n_left->n_parent = node;
+  }
+  replace_child(node->n_parent, node, left);
+  left->n_right = node;
+  node->n_parent = left;
+  update_node(node);
+  update_node(left);
+  return left;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename tree<Key, Value, Compare, Allocator>::NodeBase*
+tree<Key, Value, Compare, Allocator>::left_rotate(NodeBase* node) {
+  NodeBase* right = node->n_right;
+  node->n_right = right->n_left;
+  if (node->n_right != nullptr) {
+    node->n_right->n_parent = node;
+  }
+  replace_child(node->n_parent, node, right);
+  right->n_left = node;
+  node->n_parent = right;
+  update_node(node);
+  update_node(right);
+  return right;
 }
 
 };  // namespace s21
@@ -0,0 +1,434 @@
+#ifndef S21_MEMORY
+#define S21_MEMORY
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Base for containers that store an allocator. Stateless allocators (the
+// common case, std::allocator included) take no space thanks to the empty
+// base optimization; stateful ones are kept as a member.
+template <typename Alloc,
+          bool = std::is_empty_v<Alloc> && !std::is_final_v<Alloc>>
+class allocator_base : private Alloc {
+ protected:
+  allocator_base() = default;
+  explicit allocator_base(const Alloc &alloc) : Alloc(alloc) {}
+  explicit allocator_base(Alloc &&alloc) : Alloc(std::move(alloc)) {}
+
+  Alloc &alloc() noexcept { return *this; }
+  const Alloc &alloc() const noexcept { return *this; }
+};
+
+template <typename Alloc>
+class allocator_base<Alloc, false> {
+ protected:
+  allocator_base() = default;
+  explicit allocator_base(const Alloc &alloc) : alloc_(alloc) {}
+  explicit allocator_base(Alloc &&alloc) : alloc_(std::move(alloc)) {}
+
+  Alloc &alloc() noexcept { return alloc_; }
+  const Alloc &alloc() const noexcept { return alloc_; }
+
+ private:
+  Alloc alloc_;
+};
+
+// Propagation rules of allocator_traits, applied by the container operations
+// that replace or exchange contents.
+template <typename Alloc>
+void propagate_on_copy(Alloc &to, const Alloc &from) {
+  if constexpr (std::allocator_traits<
+                    Alloc>::propagate_on_container_copy_assignment::value) {
+    to = from;
+  }
+}
+
+template <typename Alloc>
+void propagate_on_move(Alloc &to, Alloc &from) {
+  if constexpr (std::allocator_traits<
+                    Alloc>::propagate_on_container_move_assignment::value) {
+    to = std::move(from);
+  }
+}
+
+template <typename Alloc>
+void propagate_on_swap(Alloc &a, Alloc &b) {
+  if constexpr (std::allocator_traits<
+                    Alloc>::propagate_on_container_swap::value) {
+    using std::swap;
+    swap(a, b);
+  }
+}
+
+// True when storage from `from` may be adopted by a container whose
+// allocator becomes `to` after move assignment.
+template <typename Alloc>
+bool can_steal_on_move(const Alloc &to, const Alloc &from) {
+  using traits = std::allocator_traits<Alloc>;
+  if constexpr (traits::propagate_on_container_move_assignment::value ||
+                traits::is_always_equal::value) {
+    return true;
+  } else {
+    return to == from;
+  }
+}
+
+template <typename Alloc, typename T, typename = void>
+struct has_construct : std::false_type {};
+
+template <typename Alloc, typename T>
+struct has_construct<Alloc, T,
+                     std::void_t<decltype(std::declval<Alloc &>().construct(
+                         std::declval<T *>(), std::declval<T &&>()))>>
+    : std::true_type {};
+
+// Whether constructing T through Alloc is a plain placement new, so raw
+// byte copies may stand in for it.
+template <typename Alloc, typename T>
+inline constexpr bool uses_default_construct =
+    std::is_same_v<Alloc, std::allocator<T>> || !has_construct<Alloc, T>::value;
+
+template <typename Alloc, typename T, typename = void>
+struct has_destroy : std::false_type {};
+
+template <typename Alloc, typename T>
+struct has_destroy<Alloc, T,
+                   std::void_t<decltype(std::declval<Alloc &>().destroy(
+                       std::declval<T *>()))>> : std::true_type {};
+
+// Whether destroying T through Alloc does nothing, so destruction loops may
+// be skipped.
+template <typename Alloc, typename T>
+inline constexpr bool trivially_destroyed =
+    std::is_trivially_destructible_v<T> &&
+    (std::is_same_v<Alloc, std::allocator<T>> || !has_destroy<Alloc, T>::value);
+
+// Fixed-size storage for the nodes of one container. Nodes are carved out of
+// slabs obtained from the container's node allocator and recycled through an
+// intrusive free list, so steady-state insert/erase doesn't reach the
+// allocator and neighbouring nodes share cache lines. The pool only hands
+// out raw memory; the container constructs and destroys the nodes. It
+// doesn't keep the allocator either: every call that may allocate or free a
+// slab takes it, and it must always be the same (or an equal) allocator.
+template <typename Node>
+class node_pool {
+ public:
+  using size_type = std::size_t;
+
+  node_pool() noexcept = default;
+  node_pool(const node_pool &) = delete;
+  node_pool(node_pool &&other) noexcept { swap(other); }
+  node_pool &operator=(const node_pool &) = delete;
+  node_pool &operator=(node_pool &&) = delete;
+  // The owner frees the slabs through release() with its allocator.
+  ~node_pool() { assert(slabs_ == nullptr); }
+
+  // Slots in all slabs, in use or not.
+  size_type capacity() const noexcept { return capacity_; }
+  size_type in_use() const noexcept { return live_; }
+
+  template <typename Alloc>
+  Node *allocate(Alloc &alloc) {
+    if (free_ != nullptr) {
+      slot *s = free_;
+      free_ = s->next;
+      live_++;
+      return reinterpret_cast<Node *>(s);
+    }
+    if (next_ == end_) {
+      add_slab(alloc, std::clamp(capacity_, kMinSlab, max_slab()));
+    }
+    live_++;
+    return next_++;
+  }
+
+  void deallocate(Node *p) noexcept {
+    push_free(p);
+    live_--;
+  }
+
+  // Grows the pool so that n more nodes fit without reaching the allocator.
+  template <typename Alloc>
+  void reserve(Alloc &alloc, size_type n) {
+    size_type spare = capacity_ - live_;
+    if (n > spare) {
+      add_slab(alloc, n - spare);
+    }
+  }
+
+  // Returns slabs without live nodes to the allocator.
+  template <typename Alloc>
+  void shrink_to_fit(Alloc &alloc);
+
+  // Frees every slab. All nodes must have been destroyed.
+  template <typename Alloc>
+  void release(Alloc &alloc) noexcept {
+    while (slabs_ != nullptr) {
+      slab *next = slabs_->next;
+      free_slab(alloc, slabs_);
+      slabs_ = next;
+    }
+    slab_tail_ = nullptr;
+    free_ = nullptr;
+    next_ = end_ = nullptr;
+    capacity_ = live_ = 0;
+    reclaim_at_ = 0;
+  }
+
+  // Takes over all slabs of other, live nodes included, so nodes can move
+  // from other's container to this one; other ends up empty and the two
+  // pools stay independent. Both must use equal allocators. The slab and
+  // free lists are spliced in O(1), plus the shorter unused slab rest.
+  // Containers that keep receiving nodes would otherwise pile up the
+  // memory of the ones they erase, so once this pool's spare slots have
+  // doubled since the last time, its empty slabs are freed first.
+  template <typename Alloc>
+  void adopt(Alloc &alloc, node_pool &other);
+
+  void swap(node_pool &other) noexcept {
+    std::swap(slabs_, other.slabs_);
+    std::swap(slab_tail_, other.slab_tail_);
+    std::swap(free_, other.free_);
+    std::swap(free_tail_, other.free_tail_);
+    std::swap(next_, other.next_);
+    std::swap(end_, other.end_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(live_, other.live_);
+    std::swap(reclaim_at_, other.reclaim_at_);
+  }
+
+ private:
+  struct slot {
+    slot *next;
+  };
+
+  // Kept in the first slot of every slab; the nodes follow it.
+  struct slab {
+    slab *next;
+    size_type count;
+    size_type unused;
+  };
+
+  static_assert(sizeof(Node) >= sizeof(slab) &&
+                    alignof(Node) >= alignof(slab),
+                "Error: node too small for the pool");
+
+  static constexpr size_type kMinSlab = 8;
+  static constexpr size_type kMaxSlabBytes = 64 * 1024;
+
+  static constexpr size_type max_slab() {
+    return std::max(kMinSlab, kMaxSlabBytes / sizeof(Node));
+  }
+
+  static Node *nodes(slab *s) noexcept {
+    return reinterpret_cast<Node *>(s) + 1;
+  }
+
+  // free_tail_ is only meaningful while free_ isn't empty.
+  void push_free(Node *p) noexcept {
+    slot *freed = ::new (static_cast<void *>(p)) slot{free_};
+    if (free_ == nullptr) {
+      free_tail_ = freed;
+    }
+    free_ = freed;
+  }
+
+  // Puts the unused rest of the current slab on the free list.
+  void retire_bump() noexcept {
+    while (next_ != end_) {
+      push_free(next_++);
+    }
+  }
+
+  template <typename Alloc>
+  void add_slab(Alloc &alloc, size_type count) {
+    Node *memory = std::allocator_traits<Alloc>::allocate(alloc, count + 1);
+    slab *s = ::new (static_cast<void *>(memory)) slab{slabs_, count, 0};
+    // What is left of the current slab stays usable through the free list.
+    retire_bump();
+    slabs_ = s;
+    if (slab_tail_ == nullptr) {
+      slab_tail_ = s;
+    }
+    next_ = nodes(s);
+    end_ = next_ + count;
+    capacity_ += count;
+  }
+
+  template <typename Alloc>
+  void free_slab(Alloc &alloc, slab *s) noexcept {
+    std::allocator_traits<Alloc>::deallocate(
+        alloc, reinterpret_cast<Node *>(s), s->count + 1);
+  }
+
+  slab *slabs_ = nullptr;
+  slab *slab_tail_ = nullptr;
+  slot *free_ = nullptr;
+  slot *free_tail_ = nullptr;
+  Node *next_ = nullptr;
+  Node *end_ = nullptr;
+  size_type capacity_ = 0;
+  size_type live_ = 0;
+  // Spare slots at which adopt() next looks for empty slabs.
+  size_type reclaim_at_ = 0;
+};
+
+template <typename Node>
+template <typename Alloc>
+void node_pool<Node>::adopt(Alloc &alloc, node_pool &other) {
+  if (other.slabs_ == nullptr) {
+    return;
+  }
+  if (capacity_ - live_ > reclaim_at_) {
+    shrink_to_fit(alloc);
+    reclaim_at_ = 2 * (capacity_ - live_) + kMinSlab;
+  }
+  if (other.end_ - other.next_ > end_ - next_) {
+    std::swap(next_, other.next_);
+    std::swap(end_, other.end_);
+  }
+  other.retire_bump();
+  other.slab_tail_->next = slabs_;
+  slabs_ = other.slabs_;
+  if (slab_tail_ == nullptr) {
+    slab_tail_ = other.slab_tail_;
+  }
+  if (other.free_ != nullptr) {
+    other.free_tail_->next = free_;
+    if (free_ == nullptr) {
+      free_tail_ = other.free_tail_;
+    }
+    free_ = other.free_;
+  }
+  capacity_ += other.capacity_;
+  live_ += other.live_;
+  other.slabs_ = other.slab_tail_ = nullptr;
+  other.free_ = nullptr;
+  other.next_ = other.end_ = nullptr;
+  other.capacity_ = other.live_ = 0;
+}
+
+template <typename Node>
+template <typename Alloc>
+void node_pool<Node>::shrink_to_fit(Alloc &alloc) {
+  if (live_ == 0) {
+    release(alloc);
+    return;
+  }
+  retire_bump();
+  next_ = end_ = nullptr;
+  if (free_ == nullptr) {
+    return;
+  }
+  // Count the free slots of every slab, finding a slot's slab by address.
+  size_type slab_count = 0;
+  for (slab *s = slabs_; s != nullptr; s = s->next) {
+    s->unused = 0;
+    slab_count++;
+  }
+  using slab_ptr_alloc = typename std::allocator_traits<
+      Alloc>::template rebind_alloc<slab *>;
+  using slab_ptr_traits = std::allocator_traits<slab_ptr_alloc>;
+  slab_ptr_alloc index_alloc(alloc);
+  slab **sorted = slab_ptr_traits::allocate(index_alloc, slab_count);
+  slab **out = sorted;
+  for (slab *s = slabs_; s != nullptr; s = s->next) {
+    *out++ = s;
+  }
+  std::less<const void *> before;
+  std::sort(sorted, out, before);
+  auto owner = [&](slot *p) {
+    return *(std::upper_bound(sorted, out, p, before) - 1);
+  };
+  for (slot *p = free_; p != nullptr; p = p->next) {
+    owner(p)->unused++;
+  }
+  slot **link = &free_;
+  while (*link != nullptr) {
+    slab *s = owner(*link);
+    if (s->unused == s->count) {
+      *link = (*link)->next;
+    } else {
+      free_tail_ = *link;
+      link = &(*link)->next;
+    }
+  }
+  slab_ptr_traits::deallocate(index_alloc, sorted, slab_count);
+  slab **slab_link = &slabs_;
+  slab_tail_ = nullptr;
+  while (*slab_link != nullptr) {
+    slab *s = *slab_link;
+    if (s->unused == s->count) {
+      *slab_link = s->next;
+      capacity_ -= s->count;
+      free_slab(alloc, s);
+    } else {
+      slab_tail_ = s;
+      slab_link = &s->next;
+    }
+  }
+}
+
+// A node_pool that several containers opt into sharing, so that nodes can
+// move between them by relinking alone. The containers take it at
+// construction and must be destroyed before it. Every allocation and
+// deallocation locks the pool, so containers sharing it may still be used
+// from different threads, each one by a single thread at a time.
+template <typename Node, typename Alloc>
+class shared_node_pool : private allocator_base<Alloc> {
+ public:
+  using size_type = std::size_t;
+  using allocator_type = Alloc;
+
+  shared_node_pool() = default;
+  explicit shared_node_pool(const Alloc &alloc)
+      : allocator_base<Alloc>(alloc) {}
+  shared_node_pool(const shared_node_pool &) = delete;
+  shared_node_pool &operator=(const shared_node_pool &) = delete;
+  ~shared_node_pool() {
+    assert(pool_.in_use() == 0);
+    pool_.release(this->alloc());
+  }
+
+  allocator_type get_allocator() const { return this->alloc(); }
+
+  size_type in_use() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.in_use();
+  }
+
+  Node *allocate() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pool_.allocate(this->alloc());
+  }
+
+  void deallocate(Node *p) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.deallocate(p);
+  }
+
+  void reserve(size_type n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.reserve(this->alloc(), n);
+  }
+
+  void shrink_to_fit() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pool_.shrink_to_fit(this->alloc());
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  node_pool<Node> pool_;
+};
+}  // namespace s21
+
+#endif
@@ -7,41 +7,144 @@
 #include "../s21_bntree.h"
 
 namespace s21 {
-template <class Key>
-class set : public tree<Key, Key> {
+template <class Key, class Compare = std::less<Key>,
+          class Allocator = std::allocator<Key>>
+class set : public tree<Key, Key, Compare, Allocator> {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type &;
   using const_reference = const value_type &;
-  using iterator = typename tree<Key, Key>::iterator;
-  using const_iterator = typename tree<Key, Key>::const_iterator;
+  using iterator = typename tree<Key, Key, Compare, Allocator>::iterator;
+  using const_iterator =
+      typename tree<Key, Key, Compare, Allocator>::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
 
-  set() : tree<Key, Key>(){};
+  set() : tree<Key, Key, Compare, Allocator>(){};
+  explicit set(const Allocator &alloc)
+      : tree<Key, Key, Compare, Allocator>(alloc) {}
+  explicit set(const Compare &comp, const Allocator &alloc = Allocator())
+      : tree<Key, Key, Compare, Allocator>(comp, alloc) {}
   set(std::initializer_list<value_type> const &items) {
-    for (auto i = items.begin(); i != items.end(); ++i) {
-      tree<Key, Key>::insert(*i);
-    }
+    assign(items.begin(), items.end());
+  }
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  set(InputIt first, InputIt last, const Allocator &alloc = Allocator())
+      : tree<Key, Key, Compare, Allocator>(alloc) {
+    assign(first, last);
   }
-  set(const set &other) : tree<Key, Key>(other){};
-  set(set &&other) noexcept : tree<Key, Key>(std::move(other)){};
+  set(const set &other) : tree<Key, Key, Compare, Allocator>(other){};
+  set(set &&other) noexcept
+      : tree<Key, Key, Compare, Allocator>(std::move(other)){};
   set &operator=(const set &other) {
     if (this != &other) {
-      tree<Key, Key>::operator=(other);
+      tree<Key, Key, Compare, Allocator>::operator=(other);
     }
     return *this;
   }
-  set &operator=(set &&other) noexcept {
+  set &operator=(set &&other) noexcept(
+      std::is_nothrow_move_assignable_v<tree<Key, Key, Compare, Allocator>>) {
     if (this != &other) {
-      tree<Key, Key>::operator=(std::move(other));
+      tree<Key, Key, Compare, Allocator>::operator=(std::move(other));
     }
     return *this;
   }
   ~set() = default;
 
-  iterator find(const Key &key) { return tree<Key, Key>::find(key); }
+  iterator find(const Key &key) {
+    return tree<Key, Key, Compare, Allocator>::find(key);
+  }
+  // Lookups by any type the comparator can order against Key, such as
+  // std::string_view for std::string keys with std::less<>, when Compare
+  // declares is_transparent. No temporary Key is built.
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K &key) {
+    auto node = tree<Key, Key, Compare, Allocator>::find_node(key);
+    return node == nullptr ? this->end() : iterator(node);
+  }
+  // The element at sorted position k, or end() when k >= size(); O(log n).
+  // rank() is the inverse: nth(rank(key)) finds key when it is present.
+  iterator nth(size_type k) {
+    return iterator(tree<Key, Key, Compare, Allocator>::select_node(k));
+  }
+  // The first element not less than key, and the first greater than key.
+  iterator lower_bound(const Key &key) {
+    return iterator(tree<Key, Key, Compare, Allocator>::lower_bound_node(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator lower_bound(const K &key) {
+    return iterator(tree<Key, Key, Compare, Allocator>::lower_bound_node(key));
+  }
+  iterator upper_bound(const Key &key) {
+    return iterator(tree<Key, Key, Compare, Allocator>::upper_bound_node(key));
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator upper_bound(const K &key) {
+    return iterator(tree<Key, Key, Compare, Allocator>::upper_bound_node(key));
+  }
+  // [lower_bound(key), upper_bound(key)) in one descent.
+  std::pair<iterator, iterator> equal_range(const Key &key) {
+    auto nodes = tree<Key, Key, Compare, Allocator>::equal_range_nodes(key);
+    return {iterator(nodes.first), iterator(nodes.second)};
+  }
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::pair<iterator, iterator> equal_range(const K &key) {
+    auto nodes = tree<Key, Key, Compare, Allocator>::equal_range_nodes(key);
+    return {iterator(nodes.first), iterator(nodes.second)};
+  }
+  // The elements in [lo, hi), read in place as the range is iterated. Empty
+  // when hi <= lo.
+  iterator_range<iterator> range(const Key &lo, const Key &hi) {
+    iterator first = lower_bound(lo);
+    return {first, this->key_comp()(hi, lo) ? first : lower_bound(hi)};
+  }
+  // Replaces the contents with [first, last). Sorted input without
+  // duplicates is built in linear time; anything else is sorted first.
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  void assign(InputIt first, InputIt last) {
+    tree<Key, Key, Compare, Allocator>::assign_unique(
+        first, last, [](const Key &key) {
+          return std::pair<const Key &, const Key &>(key, key);
+        });
+  }
 };
+
+// Set algebra on two sets, built into a new set with a's comparator and
+// allocator. Where keys match, the element comes from a. See
+// tree::assign_union().
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_union(
+    const set<Key, Compare, Allocator> &a,
+    const set<Key, Compare, Allocator> &b) {
+  set<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assign_union(a, b);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_intersection(
+    const set<Key, Compare, Allocator> &a,
+    const set<Key, Compare, Allocator> &b) {
+  set<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assign_intersection(a, b);
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator> set_difference(
+    const set<Key, Compare, Allocator> &a,
+    const set<Key, Compare, Allocator> &b) {
+  set<Key, Compare, Allocator> result(a.key_comp(), a.get_allocator());
+  result.assign_difference(a, b);
+  return result;
+}
 }  // namespace s21
 
 #endif
\ No newline at end of file
@@ -0,0 +1,24 @@
+#ifndef S21_SMALL_VECTOR
+#define S21_SMALL_VECTOR
+
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+// vector that keeps up to N elements inside the object and only allocates
+// once it grows past them. Same interface as s21::vector; moving or
+// swapping a small_vector whose elements are inline moves them one by one.
+template <typename T, size_t N, typename Allocator = std::allocator<T>,
+          typename Growth = default_growth>
+class small_vector : public basic_vector<T, Allocator, Growth, N> {
+  static_assert(N > 0, "Error: use s21::vector for no inline capacity");
+
+ public:
+  using basic_vector<T, Allocator, Growth, N>::basic_vector;
+
+  static constexpr size_t inline_capacity() { return N; }
+
+  bool is_small() const { return this->is_inline(); }
+};
+}  // namespace s21
+
+#endif
@@ -4,7 +4,11 @@
 #include "../vector/s21_vector.h"
 
 namespace s21 {
-template <typename T>
+// Container is any sequence with push_back, pop_back, back, size and empty:
+// s21::vector by default, s21::small_vector<T, N> for small stacks that
+// should not touch the heap. The allocator is chosen through the container,
+// e.g. stack<T, s21::vector<T, Alloc>>.
+template <typename T, typename Container = s21::vector<T>>
 class stack {
  public:
   using value_type = T;
@@ -13,12 +17,13 @@ class stack {
   using iterator = T *;
   using const_iterator = const T *;
   using size_type = size_t;
+  using container_type = Container;
 
   stack() : data_() {}
   stack(std::initializer_list<value_type> const &items) : data_(items) {}
   stack(const stack &s) : data_(s.data_) {}
   stack(stack &&s) : data_(std::move(s.data_)) {}
-  ~stack() { data_.~vector(); }
+  ~stack() = default;
 
   stack operator=(stack &&s) {
     data_ = std::move(s.data_);
@@ -37,7 +42,7 @@ class stack {
   const_reference top() { return data_.back(); }
 
  private:
-  s21::vector<value_type> data_;
+  container_type data_;
 };
 }  // namespace s21
 
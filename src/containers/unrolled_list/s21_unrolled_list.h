@@ -0,0 +1,606 @@
+#ifndef S21_UNROLLED_LIST_H
+#define S21_UNROLLED_LIST_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <utility>
+
+#include "../list/s21_list.h"
+#include "../s21_memory.h"
+
+namespace s21 {
+// One node of an unrolled_list: up to N elements kept in [0, count) of an
+// inline array, linked into the list's ring like a list_node.
+template <class T, size_t N>
+struct unrolled_chunk : list_node_base {
+  size_t count = 0;
+  alignas(T) unsigned char storage[N * sizeof(T)];
+
+  T *elements() { return reinterpret_cast<T *>(storage); }
+  const T *elements() const { return reinterpret_cast<const T *>(storage); }
+};
+
+// A list whose nodes each hold up to ChunkSize elements, in the same ring
+// through a sentinel as s21::list. A scan reads a chunk's elements from one
+// contiguous array before it follows a pointer, and a chunk is one node_pool
+// slot. Insert and erase move at most ChunkSize elements inside one chunk:
+// a full chunk is split in half, an insert at the front of a full chunk
+// starts a new one, and a chunk that drops below half full absorbs its
+// successor when both fit. Both invalidate iterators into the chunks they
+// touch, which are the one at pos and the one after it.
+template <class T, size_t ChunkSize = 16, class Allocator = std::allocator<T>>
+class unrolled_list
+    : private allocator_base<typename std::allocator_traits<
+          Allocator>::template rebind_alloc<unrolled_chunk<T, ChunkSize>>> {
+  static_assert(ChunkSize >= 2, "Error: chunks must hold two elements");
+
+ public:
+  using Chunk = unrolled_chunk<T, ChunkSize>;
+  using NodeBase = list_node_base;
+
+ private:
+  using chunk_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Chunk>;
+  using chunk_traits = std::allocator_traits<chunk_allocator>;
+  static constexpr bool kStealsOnMove =
+      chunk_traits::propagate_on_container_move_assignment::value ||
+      chunk_traits::is_always_equal::value;
+
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  class const_iterator {
+   public:
+    using value_type = unrolled_list::value_type;
+    using reference = unrolled_list::const_reference;
+    using size_type = unrolled_list::size_type;
+
+    reference operator*() const noexcept {
+      assert(m_chunk != nullptr);
+      return static_cast<const Chunk *>(m_chunk)->elements()[m_index];
+    }
+
+    const_iterator &operator++() noexcept {
+      assert(m_chunk != nullptr);
+      if (++m_index == static_cast<const Chunk *>(m_chunk)->count) {
+        m_chunk = m_chunk->next;
+        m_index = 0;
+      }
+      return *this;
+    }
+
+    const_iterator &operator--() noexcept {
+      assert(m_chunk != nullptr);
+      if (m_index == 0) {
+        m_chunk = m_chunk->prev;
+        m_index = static_cast<const Chunk *>(m_chunk)->count;
+      }
+      m_index--;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    const_iterator operator--(int) noexcept {
+      auto copy = *this;
+      --*this;
+      return copy;
+    }
+
+    bool operator==(const_iterator other) const noexcept {
+      return m_chunk == other.m_chunk && m_index == other.m_index;
+    }
+
+    bool operator!=(const_iterator other) const noexcept {
+      return !(*this == other);
+    }
+
+   protected:
+    friend class unrolled_list;
+
+    const_iterator(const NodeBase *chunk, size_type index) noexcept
+        : m_chunk{chunk}, m_index{index} {}
+
+    // The element at (m_chunk, m_index); end() is (sentinel, 0).
+    const NodeBase *m_chunk;
+    size_type m_index;
+  };
+
+  class iterator : public const_iterator {
+   public:
+    using value_type = unrolled_list::value_type;
+    using pointer = unrolled_list::pointer;
+    using reference = unrolled_list::reference;
+
+    reference operator*() const noexcept {
+      return const_cast<reference>(const_iterator::operator*());
+    }
+
+    iterator &operator++() noexcept {
+      const_iterator::operator++();
+      return *this;
+    }
+
+    iterator &operator--() noexcept {
+      const_iterator::operator--();
+      return *this;
+    }
+
+    iterator operator++(int) noexcept {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+
+    iterator operator--(int) noexcept {
+      auto copy = *this;
+      --*this;
+      return copy;
+    }
+
+   private:
+    friend class unrolled_list;
+
+    iterator(const NodeBase *chunk, size_type index) noexcept
+        : const_iterator{chunk, index} {}
+  };
+
+  unrolled_list() noexcept;
+  explicit unrolled_list(const Allocator &alloc) noexcept;
+  unrolled_list(std::initializer_list<value_type> const &items,
+                const Allocator &alloc = Allocator());
+  unrolled_list(const unrolled_list &other);
+  unrolled_list(unrolled_list &&other) noexcept;
+  ~unrolled_list();
+  unrolled_list &operator=(const unrolled_list &other);
+  unrolled_list &operator=(unrolled_list &&other) noexcept(kStealsOnMove);
+
+  allocator_type get_allocator() const { return allocator_type(this->alloc()); }
+  const_reference front() const;
+  const_reference back() const;
+  bool empty() const { return m_size == 0; }
+  size_type size() const { return m_size; }
+  size_type max_size() const {
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+  }
+  // Chunks in use; size() / chunk_count() is the fill.
+  size_type chunk_count() const { return m_pool.in_use(); }
+
+  iterator begin() { return iterator(m_sentinel.next, 0); }
+  iterator end() { return iterator(&m_sentinel, 0); }
+  const_iterator begin() const { return const_iterator(m_sentinel.next, 0); }
+  const_iterator end() const { return const_iterator(&m_sentinel, 0); }
+
+  void push_back(const T &value) { insert_one(end(), value); }
+  void push_back(T &&value) { insert_one(end(), std::move(value)); }
+  void push_front(const T &value) { insert_one(begin(), value); }
+  void push_front(T &&value) { insert_one(begin(), std::move(value)); }
+  void pop_back();
+  void pop_front();
+  // Inserts before pos and returns the new element.
+  iterator insert(const_iterator pos, const_reference value) {
+    return insert_one(pos, value);
+  }
+  iterator insert(const_iterator pos, value_type &&value) {
+    return insert_one(pos, std::move(value));
+  }
+  // Returns the element after the last one removed.
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  void clear();
+  void swap(unrolled_list &other);
+  // Moves all of other in before pos. With equal allocators the chunks are
+  // relinked, after splitting the chunk at pos when pos is inside one:
+  // O(ChunkSize). Otherwise the elements are moved one by one.
+  void splice(const_iterator pos, unrolled_list &other);
+
+ private:
+  NodeBase m_sentinel;
+  size_type m_size;
+  node_pool<Chunk> m_pool;
+
+  static Chunk *as_chunk(NodeBase *node) { return static_cast<Chunk *>(node); }
+  static const Chunk *as_chunk(const NodeBase *node) {
+    return static_cast<const Chunk *>(node);
+  }
+  void reset_sentinel() noexcept;
+  void relink_sentinel() noexcept;
+  Chunk *create_chunk(NodeBase *pos);
+  void destroy_chunk(Chunk *chunk);
+  template <typename... Args>
+  void construct_at(T *p, Args &&...args);
+  void destroy_at(T *p);
+  template <typename U>
+  iterator insert_one(const_iterator pos, U &&value);
+  void open_slot(Chunk *chunk, size_type index, T &&value);
+  void close_slot(Chunk *chunk, size_type index);
+  Chunk *split(Chunk *chunk, size_type at);
+  void absorb_next(Chunk *chunk);
+  void append_all(const unrolled_list &other);
+};
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator>::unrolled_list() noexcept
+    : m_sentinel{&m_sentinel, &m_sentinel}, m_size(0) {}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator>::unrolled_list(
+    const Allocator &alloc) noexcept
+    : allocator_base<chunk_allocator>(chunk_allocator(alloc)),
+      m_sentinel{&m_sentinel, &m_sentinel},
+      m_size(0) {}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator>::unrolled_list(
+    std::initializer_list<value_type> const &items, const Allocator &alloc)
+    : unrolled_list(alloc) {
+  for (const T &value : items) {
+    push_back(value);
+  }
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator>::unrolled_list(
+    const unrolled_list &other)
+    : unrolled_list(Allocator(
+          chunk_traits::select_on_container_copy_construction(other.alloc()))) {
+  append_all(other);
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator>::unrolled_list(
+    unrolled_list &&other) noexcept
+    : allocator_base<chunk_allocator>(std::move(other.alloc())),
+      m_sentinel(other.m_sentinel),
+      m_size(other.m_size),
+      m_pool(std::move(other.m_pool)) {
+  relink_sentinel();
+  other.m_size = 0;
+  other.reset_sentinel();
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator>::~unrolled_list() {
+  clear();
+  m_pool.release(this->alloc());
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator> &
+unrolled_list<T, ChunkSize, Allocator>::operator=(const unrolled_list &other) {
+  if (this != &other) {
+    if constexpr (chunk_traits::propagate_on_container_copy_assignment::value) {
+      if (this->alloc() != other.alloc()) {
+        clear();
+        m_pool.release(this->alloc());
+      }
+    }
+    propagate_on_copy(this->alloc(), other.alloc());
+    clear();
+    append_all(other);
+  }
+  return *this;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+unrolled_list<T, ChunkSize, Allocator> &
+unrolled_list<T, ChunkSize, Allocator>::operator=(
+    unrolled_list &&other) noexcept(kStealsOnMove) {
+  if (this != &other) {
+    clear();
+    if (can_steal_on_move(this->alloc(), other.alloc())) {
+      m_pool.release(this->alloc());
+      propagate_on_move(this->alloc(), other.alloc());
+      m_sentinel = other.m_sentinel;
+      m_size = other.m_size;
+      relink_sentinel();
+      other.m_size = 0;
+      other.reset_sentinel();
+      m_pool.swap(other.m_pool);
+    } else {
+      for (iterator it = other.begin(); it != other.end(); ++it) {
+        push_back(std::move(*it));
+      }
+      other.clear();
+    }
+  }
+  return *this;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+const T &unrolled_list<T, ChunkSize, Allocator>::front() const {
+  return as_chunk(m_sentinel.next)->elements()[0];
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+const T &unrolled_list<T, ChunkSize, Allocator>::back() const {
+  const Chunk *last = as_chunk(m_sentinel.prev);
+  return last->elements()[last->count - 1];
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::pop_back() {
+  if (m_size == 0) return;
+  Chunk *last = as_chunk(m_sentinel.prev);
+  erase(const_iterator(last, last->count - 1));
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::pop_front() {
+  if (m_size == 0) return;
+  erase(begin());
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::clear() {
+  NodeBase *node = m_sentinel.next;
+  while (node != &m_sentinel) {
+    NodeBase *next = node->next;
+    Chunk *chunk = as_chunk(node);
+    for (size_type i = 0; i < chunk->count; i++) {
+      destroy_at(chunk->elements() + i);
+    }
+    m_pool.deallocate(chunk);
+    node = next;
+  }
+  reset_sentinel();
+  m_size = 0;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::swap(unrolled_list &other) {
+  propagate_on_swap(this->alloc(), other.alloc());
+  std::swap(m_sentinel, other.m_sentinel);
+  std::swap(m_size, other.m_size);
+  relink_sentinel();
+  other.relink_sentinel();
+  m_pool.swap(other.m_pool);
+}
+
+// Elements are stored at [0, count) of each chunk, so an iterator never
+// rests on index count; inserting at the end of a chunk is inserting
+// before the first element of the next one. value may refer into this
+// list, and a split moves elements out of the chunk at pos, so it is
+// copied out before any chunk changes.
+template <class T, size_t ChunkSize, class Allocator>
+template <typename U>
+typename unrolled_list<T, ChunkSize, Allocator>::iterator
+unrolled_list<T, ChunkSize, Allocator>::insert_one(const_iterator pos,
+                                                   U &&value) {
+  T item(std::forward<U>(value));
+  NodeBase *node = const_cast<NodeBase *>(pos.m_chunk);
+  size_type index = pos.m_index;
+  Chunk *chunk;
+  if (index == 0) {
+    // Before the first element of node: append to the previous chunk when
+    // it has room, else start a chunk here if node is full or the end.
+    NodeBase *prev = node->prev;
+    if (prev != &m_sentinel && as_chunk(prev)->count < ChunkSize) {
+      chunk = as_chunk(prev);
+      index = chunk->count;
+    } else if (node == &m_sentinel || as_chunk(node)->count == ChunkSize) {
+      chunk = create_chunk(node);
+    } else {
+      chunk = as_chunk(node);
+    }
+  } else {
+    chunk = as_chunk(node);
+    if (chunk->count == ChunkSize) {
+      Chunk *upper = split(chunk, ChunkSize / 2);
+      if (index > chunk->count) {
+        index -= chunk->count;
+        chunk = upper;
+      }
+    }
+  }
+  open_slot(chunk, index, std::move(item));
+  m_size++;
+  return iterator(chunk, index);
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+typename unrolled_list<T, ChunkSize, Allocator>::iterator
+unrolled_list<T, ChunkSize, Allocator>::erase(const_iterator pos) {
+  NodeBase *node = const_cast<NodeBase *>(pos.m_chunk);
+  if (node == &m_sentinel) return end();
+
+  Chunk *chunk = as_chunk(node);
+  size_type index = pos.m_index;
+  close_slot(chunk, index);
+  m_size--;
+  if (chunk->count == 0) {
+    NodeBase *next = chunk->next;
+    destroy_chunk(chunk);
+    return iterator(next, 0);
+  }
+  if (chunk->count < ChunkSize / 2) {
+    absorb_next(chunk);
+  }
+  if (index == chunk->count) {
+    return iterator(chunk->next, 0);
+  }
+  return iterator(chunk, index);
+}
+
+// Erasing can merge chunks and move the element last refers to, so the
+// range is counted first and then erased one element at a time.
+template <class T, size_t ChunkSize, class Allocator>
+typename unrolled_list<T, ChunkSize, Allocator>::iterator
+unrolled_list<T, ChunkSize, Allocator>::erase(const_iterator first,
+                                              const_iterator last) {
+  size_type count = 0;
+  for (const_iterator it = first; it != last; ++it) {
+    count++;
+  }
+  iterator it(first.m_chunk, first.m_index);
+  for (; count > 0; count--) {
+    it = erase(it);
+  }
+  return it;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::splice(const_iterator pos,
+                                                    unrolled_list &other) {
+  if (this == &other || other.m_size == 0) {
+    return;
+  }
+  if (this->alloc() != other.alloc()) {
+    for (iterator it = other.begin(); it != other.end(); ++it) {
+      pos = ++insert_one(pos, std::move(*it));
+    }
+    other.clear();
+    return;
+  }
+  NodeBase *node = const_cast<NodeBase *>(pos.m_chunk);
+  if (pos.m_index > 0) {
+    node = split(as_chunk(node), pos.m_index);
+  }
+  m_pool.adopt(this->alloc(), other.m_pool);
+  NodeBase *first = other.m_sentinel.next;
+  NodeBase *last = other.m_sentinel.prev;
+  first->prev = node->prev;
+  last->next = node;
+  node->prev->next = first;
+  node->prev = last;
+  m_size += other.m_size;
+  other.m_size = 0;
+  other.reset_sentinel();
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::reset_sentinel() noexcept {
+  m_sentinel.next = m_sentinel.prev = &m_sentinel;
+}
+
+// Points the first and last chunk back at this list's sentinel after its
+// links were copied from another list; m_size must already be set.
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::relink_sentinel() noexcept {
+  if (m_size == 0) {
+    reset_sentinel();
+  } else {
+    m_sentinel.next->prev = &m_sentinel;
+    m_sentinel.prev->next = &m_sentinel;
+  }
+}
+
+// An empty chunk linked in before pos.
+template <class T, size_t ChunkSize, class Allocator>
+typename unrolled_list<T, ChunkSize, Allocator>::Chunk *
+unrolled_list<T, ChunkSize, Allocator>::create_chunk(NodeBase *pos) {
+  Chunk *chunk = ::new (static_cast<void *>(m_pool.allocate(this->alloc())))
+      Chunk;
+  NodeBase *prev = pos->prev;
+  chunk->prev = prev;
+  chunk->next = pos;
+  prev->next = chunk;
+  pos->prev = chunk;
+  return chunk;
+}
+
+// Unlinks an empty chunk and returns it to the pool.
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::destroy_chunk(Chunk *chunk) {
+  chunk->prev->next = chunk->next;
+  chunk->next->prev = chunk->prev;
+  m_pool.deallocate(chunk);
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+template <typename... Args>
+void unrolled_list<T, ChunkSize, Allocator>::construct_at(T *p,
+                                                          Args &&...args) {
+  chunk_traits::construct(this->alloc(), p, std::forward<Args>(args)...);
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::destroy_at(T *p) {
+  chunk_traits::destroy(this->alloc(), p);
+}
+
+// Puts value at index of a chunk with room, shifting the elements from
+// index on up by one. value must not refer into the list.
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::open_slot(Chunk *chunk,
+                                                       size_type index,
+                                                       T &&value) {
+  T *elements = chunk->elements();
+  size_type count = chunk->count;
+  if (index == count) {
+    construct_at(elements + count, std::move(value));
+  } else {
+    construct_at(elements + count, std::move(elements[count - 1]));
+    std::move_backward(elements + index, elements + count - 1,
+                       elements + count);
+    elements[index] = std::move(value);
+  }
+  chunk->count++;
+}
+
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::close_slot(Chunk *chunk,
+                                                        size_type index) {
+  T *elements = chunk->elements();
+  std::move(elements + index + 1, elements + chunk->count, elements + index);
+  destroy_at(elements + chunk->count - 1);
+  chunk->count--;
+}
+
+// Moves the elements from at on into a new chunk right after chunk and
+// returns the new chunk.
+template <class T, size_t ChunkSize, class Allocator>
+typename unrolled_list<T, ChunkSize, Allocator>::Chunk *
+unrolled_list<T, ChunkSize, Allocator>::split(Chunk *chunk, size_type at) {
+  Chunk *upper = create_chunk(chunk->next);
+  T *from = chunk->elements();
+  T *to = upper->elements();
+  for (size_type i = at; i < chunk->count; i++) {
+    construct_at(to + upper->count, std::move(from[i]));
+    upper->count++;
+    destroy_at(from + i);
+  }
+  chunk->count = at;
+  return upper;
+}
+
+// Moves the next chunk's elements to the end of chunk when they all fit.
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::absorb_next(Chunk *chunk) {
+  if (chunk->next == &m_sentinel) return;
+  Chunk *next = as_chunk(chunk->next);
+  if (chunk->count + next->count > ChunkSize) return;
+  T *from = next->elements();
+  T *to = chunk->elements();
+  for (size_type i = 0; i < next->count; i++) {
+    construct_at(to + chunk->count, std::move(from[i]));
+    chunk->count++;
+    destroy_at(from + i);
+  }
+  next->count = 0;
+  destroy_chunk(next);
+}
+
+// Copies fill every chunk but the last.
+template <class T, size_t ChunkSize, class Allocator>
+void unrolled_list<T, ChunkSize, Allocator>::append_all(
+    const unrolled_list &other) {
+  for (const_iterator it = other.begin(); it != other.end(); ++it) {
+    push_back(*it);
+  }
+}
+}  // namespace s21
+
+#endif
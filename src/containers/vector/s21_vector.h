@@ -2,13 +2,140 @@
 #define S21_VECTOR
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "../s21_memory.h"
 
 namespace s21 {
+// Defining S21_CONTAINERS_CHECKED (debug builds) turns on bounds checks for
+// operator[] and validation of the iterators passed to insert and erase.
+// Release builds skip them; at() always checks.
+#ifdef S21_CONTAINERS_CHECKED
+inline constexpr bool kCheckedMode = true;
+#else
+inline constexpr bool kCheckedMode = false;
+#endif
+
+// Growth policies decide the new capacity when push_back runs out of room.
+// A policy is any copyable callable taking (current capacity, required
+// capacity) and returning the capacity to allocate; vector never allocates
+// less than the required amount, whatever the policy returns. A policy that
+// isn't default-constructible, such as a lambda, must be passed to every
+// constructor but the copy and move ones; one that can't be assigned is
+// rebuilt in place by assignment and swap.
+
+// Multiplies the capacity by Num / Den: amortized O(1) push_back.
+template <size_t Num = 2, size_t Den = 1>
+struct geometric_growth {
+  static_assert(Num > Den, "Error: growth factor must be greater than 1");
+
+  size_t operator()(size_t capacity, size_t required) const {
+    size_t grown = capacity + capacity / Den * (Num - Den) +
+                   capacity % Den * (Num - Den) / Den;
+    return grown > required ? grown : required;
+  }
+};
+
+// Adds Step slots at a time: bounded slack for memory-tight builds, at the
+// price of O(n / Step) reallocations.
+template <size_t Step>
+struct fixed_growth {
+  static_assert(Step > 0, "Error: growth step must be positive");
+
+  size_t operator()(size_t capacity, size_t required) const {
+    size_t grown = capacity + Step;
+    return grown > required ? grown : required;
+  }
+};
+
+using default_growth = geometric_growth<2, 1>;
+
+// Space for N elements inside the container object itself; empty for N == 0
+// so a plain vector pays nothing for it.
+template <typename T, size_t N>
+class inline_storage {
+ protected:
+  T *inline_data() { return reinterpret_cast<T *>(buffer_); }
+  const T *inline_data() const {
+    return reinterpret_cast<const T *>(buffer_);
+  }
+
+ private:
+  alignas(T) unsigned char buffer_[sizeof(T) * N];
+};
+
 template <typename T>
-class vector {
+class inline_storage<T, 0> {
+ protected:
+  T *inline_data() { return nullptr; }
+  const T *inline_data() const { return nullptr; }
+};
+
+// Holds a vector's growth policy. Like allocator_base, an empty policy such
+// as geometric_growth takes no space.
+template <typename Growth,
+          bool = std::is_empty_v<Growth> && !std::is_final_v<Growth>>
+class growth_base : private Growth {
+ protected:
+  growth_base() = default;
+  explicit growth_base(const Growth &growth) : Growth(growth) {}
+  explicit growth_base(Growth &&growth) : Growth(std::move(growth)) {}
+
+  Growth &policy() noexcept { return *this; }
+  const Growth &policy() const noexcept { return *this; }
+};
+
+template <typename Growth>
+class growth_base<Growth, false> {
+ protected:
+  growth_base() = default;
+  explicit growth_base(const Growth &growth) : growth_(growth) {}
+  explicit growth_base(Growth &&growth) : growth_(std::move(growth)) {}
+
+  Growth &policy() noexcept { return growth_; }
+  const Growth &policy() const noexcept { return growth_; }
+
+ private:
+  Growth growth_;
+};
+
+// Gives policy the value of growth. A policy that can't be assigned, such as
+// a lambda, is destroyed and constructed again in place; the new value is
+// built first so that a throwing copy leaves the old policy alone.
+template <typename Growth, typename G>
+void replace_policy(Growth &policy, G &&growth) {
+  if constexpr (std::is_assignable_v<Growth &, G>) {
+    policy = std::forward<G>(growth);
+  } else {
+    static_assert(std::is_nothrow_move_constructible_v<Growth>,
+                  "Error: growth policy must be assignable or nothrow "
+                  "move constructible");
+    Growth replacement(std::forward<G>(growth));
+    policy.~Growth();
+    ::new (static_cast<void *>(std::addressof(policy)))
+        Growth(std::move(replacement));
+  }
+}
+
+// Shared implementation of vector and small_vector. With N > 0 the first N
+// elements live in the inline buffer and the heap is only used past that.
+// Elements are built and destroyed through allocator_traits; allocator
+// propagation on copy, move and swap follows the standard containers.
+template <typename T, typename Allocator, typename Growth, size_t N>
+class basic_vector : private inline_storage<T, N>,
+                     private allocator_base<Allocator>,
+                     private growth_base<Growth> {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                "Error: allocator value_type must match the vector's");
+  static_assert(std::is_copy_constructible_v<Growth>,
+                "Error: growth policy must be copyable");
+
  public:
   using value_type = T;
   using reference = T &;
@@ -16,56 +143,117 @@ class vector {
   using iterator = T *;
   using const_iterator = const T *;
   using size_type = size_t;
-
-  vector() : arr_(nullptr), size_(0), capacity_(0) {}
-
-  explicit vector(size_type n) : vector() {
+  using growth_policy = Growth;
+  using allocator_type = Allocator;
+
+  basic_vector()
+      : arr_(this->inline_data()),
+        size_(0),
+        capacity_(N) {}
+
+  explicit basic_vector(const allocator_type &alloc)
+      : allocator_base<Allocator>(alloc),
+        arr_(this->inline_data()),
+        size_(0),
+        capacity_(N) {}
+
+  explicit basic_vector(const growth_policy &growth,
+                        const allocator_type &alloc = allocator_type())
+      : allocator_base<Allocator>(alloc),
+        growth_base<Growth>(growth),
+        arr_(this->inline_data()),
+        size_(0),
+        capacity_(N) {}
+
+  explicit basic_vector(size_type n,
+                        const allocator_type &alloc = allocator_type())
+      : basic_vector(n, growth_policy(), alloc) {}
+
+  basic_vector(size_type n, const growth_policy &growth,
+               const allocator_type &alloc = allocator_type())
+      : basic_vector(growth, alloc) {
+    reserve(n);
+    construct_n(arr_, n);
     size_ = n;
-    capacity_ = n;
-    n > 0 ? arr_ = new value_type[n] : arr_ = nullptr;
   }
 
-  vector(std::initializer_list<value_type> const &baza) : vector() {
+  basic_vector(std::initializer_list<value_type> const &baza,
+               const allocator_type &alloc = allocator_type())
+      : basic_vector(baza, growth_policy(), alloc) {}
+
+  basic_vector(std::initializer_list<value_type> const &baza,
+               const growth_policy &growth,
+               const allocator_type &alloc = allocator_type())
+      : basic_vector(growth, alloc) {
+    reserve(baza.size());
+    copy_construct(baza.begin(), baza.end(), arr_);
     size_ = baza.size();
-    capacity_ = baza.size();
-    arr_ = new value_type[capacity_];
-    std::copy(baza.begin(), baza.end(), arr_);
   }
 
-  vector(const vector &v) : vector() { operator=(v); }
+  basic_vector(const basic_vector &v)
+      : basic_vector(v, alloc_traits::select_on_container_copy_construction(
+                            v.alloc())) {}
+
+  basic_vector(const basic_vector &v, const allocator_type &alloc)
+      : basic_vector(v.policy(), alloc) {
+    reserve(v.size_);
+    copy_construct(v.arr_, v.arr_ + v.size_, arr_);
+    size_ = v.size_;
+  }
+
+  basic_vector(basic_vector &&v) noexcept(N == 0 || kNothrowRelocate)
+      : allocator_base<Allocator>(std::move(v.alloc())),
+        growth_base<Growth>(std::move(v.policy())),
+        arr_(this->inline_data()),
+        size_(0),
+        capacity_(N) {
+    steal(v);
+  }
 
-  vector(vector &&v) : vector() { operator=(std::move(v)); }
+  basic_vector(basic_vector &&v, const allocator_type &alloc)
+      : basic_vector(v.policy(), alloc) {
+    if (this->alloc() == v.alloc()) {
+      steal(v);
+    } else {
+      move_elements(v);
+    }
+  }
 
-  ~vector() { delV(); }
+  ~basic_vector() { delV(); }
 
-  vector &operator=(const vector &v) {
+  basic_vector &operator=(const basic_vector &v) {
     if (this != &v) {
-      delV();
-      size_ = v.size_;
-      capacity_ = v.capacity_;
-      if (size_ > 0) {
-        arr_ = new value_type[capacity_];
-        for (size_type i = 0; i < size_; i++) {
-          arr_[i] = v.arr_[i];
+      if constexpr (alloc_traits::propagate_on_container_copy_assignment::
+                        value) {
+        if (this->alloc() != v.alloc()) {
+          delV();
         }
       }
+      propagate_on_copy(this->alloc(), v.alloc());
+      basic_vector copy(v, this->alloc());
+      swap_storage(copy);
     }
     return *this;
   }
 
-  vector &operator=(vector &&v) {
+  basic_vector &operator=(basic_vector &&v) noexcept(kNothrowMoveAssign) {
     if (this != &v) {
-      delV();
-      size_ = v.size_;
-      capacity_ = v.capacity_;
-      arr_ = v.arr_;
-      v.arr_ = nullptr;
-      v.size_ = 0;
-      v.capacity_ = 0;
+      if (can_steal_on_move(this->alloc(), v.alloc())) {
+        delV();
+        propagate_on_move(this->alloc(), v.alloc());
+        replace_policy(this->policy(), std::move(v.policy()));
+        steal(v);
+      } else {
+        clear();
+        replace_policy(this->policy(), v.policy());
+        move_elements(v);
+      }
     }
     return *this;
   }
 
+  allocator_type get_allocator() const { return this->alloc(); }
+
   reference at(const size_type pos) {
     if (pos >= size_) {
       throw std::out_of_range("Error: invalid index");
@@ -73,7 +261,23 @@ class vector {
     return arr_[pos];
   }
 
-  inline reference operator[](const size_type pos) { return at(pos); }
+  const_reference at(const size_type pos) const {
+    if (pos >= size_) {
+      throw std::out_of_range("Error: invalid index");
+    }
+    return arr_[pos];
+  }
+
+  // Unchecked unless built with S21_CONTAINERS_CHECKED.
+  inline reference operator[](const size_type pos) {
+    check_index(pos);
+    return arr_[pos];
+  }
+
+  inline const_reference operator[](const size_type pos) const {
+    check_index(pos);
+    return arr_[pos];
+  }
 
   const_reference front() const {
     if (empty()) {
@@ -89,21 +293,27 @@ class vector {
     return arr_[size_ - 1];
   }
 
-  inline iterator data() { return &arr_[0]; }
+  inline iterator data() { return arr_; }
 
-  inline iterator begin() { return &arr_[0]; }
+  inline const_iterator data() const { return arr_; }
 
-  inline const_iterator begin() const { return &arr_[0]; }
+  inline iterator begin() { return arr_; }
 
-  inline iterator end() { return &arr_[size_]; }
+  inline const_iterator begin() const { return arr_; }
 
-  inline const_iterator end() const { return &arr_[size_]; }
+  inline iterator end() { return arr_ + size_; }
 
-  inline bool empty() const { return begin() == end(); }
+  inline const_iterator end() const { return arr_ + size_; }
 
-  inline size_type size() { return std::distance(begin(), end()); }
+  inline const_iterator cbegin() const { return arr_; }
 
-  inline size_type max_size() {
+  inline const_iterator cend() const { return arr_ + size_; }
+
+  inline bool empty() const { return size_ == 0; }
+
+  inline size_type size() const { return size_; }
+
+  inline size_type max_size() const {
     return std::numeric_limits<size_type>::max() / sizeof(size_type);
   }
 
@@ -112,13 +322,7 @@ class vector {
       throw std::length_error("Error: out of range memory");
     }
     if (size > capacity_) {
-      iterator temp = arr_;
-      arr_ = new value_type[size];
-      for (size_type i = 0; i < size_; i++) {
-        arr_[i] = temp[i];
-      }
-      delete[] temp;
-      capacity_ = size;
+      reallocate(size);
     }
   }
 
@@ -126,87 +330,199 @@ class vector {
     if (size > max_size()) {
       throw std::length_error("Error: out of range memory");
     }
-    if (size > capacity_) {
+    if (size < size_) {
+      destroy(arr_ + size, arr_ + size_);
+    } else if (size > size_) {
       reserve(size);
-      size_ = size;
-    }
-
-    if (size < capacity_) {
-      iterator temp = arr_;
-      arr_ = new value_type[size];
-      for (size_type i = 0; i < size; i++) {
-        arr_[i] = temp[i];
-      }
-      delete[] temp;
-      size_ = size;
+      construct_n(arr_ + size_, size - size_);
     }
+    size_ = size;
   }
 
-  size_type capacity() { return capacity_; }
+  size_type capacity() const { return capacity_; }
+
+  inline growth_policy growth() const { return this->policy(); }
 
   void reduce() {
-    capacity_ = size_;
-    reserve(capacity_);
+    if (size_ == 0) {
+      delV();
+    } else if (capacity_ > size_ && !is_inline()) {
+      reallocate(size_);
+    }
   }
 
-  inline void clear() { size_ = 0; }
+  inline void clear() {
+    destroy(arr_, arr_ + size_);
+    size_ = 0;
+  }
 
   void pop_back() {
     if (size_ == 0) {
       throw std::length_error("Error: empty size");
     }
     size_ -= 1;
+    destroy(arr_ + size_, arr_ + size_ + 1);
   }
 
-  void push_back(const_reference value) {
+  void push_back(const_reference value) { emplace_back(value); }
+
+  void push_back(value_type &&value) { emplace_back(std::move(value)); }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
     if (size_ >= capacity_) {
-      if (capacity_ == 0) {
-        reserve(1);
-      } else {
-        reserve(capacity_ + 2);
-      }
+      realloc_insert(size_, 1, [&](iterator dest) {
+        construct(dest, std::forward<Args>(args)...);
+      });
+    } else {
+      construct(arr_ + size_, std::forward<Args>(args)...);
+      size_++;
     }
-    arr_[size_] = value;
-    size_++;
+    return arr_[size_ - 1];
   }
 
-  void swap(vector &other) {
-    std::swap(arr_, other.arr_);
-    std::swap(size_, other.size_);
-    std::swap(capacity_, other.capacity_);
+  void swap(basic_vector &other) {
+    propagate_on_swap(this->alloc(), other.alloc());
+    swap_storage(other);
   }
 
   void sort() { std::sort(begin(), end()); }
 
   iterator insert(iterator pos, const_reference value) {
-    if (pos < begin() || pos > end()) {
-      throw std::length_error("Error: invalid area of memory");
+    return emplace(pos, value);
+  }
+
+  iterator insert(iterator pos, value_type &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  // Inserts [first, last) before pos with a single shift of the tail when
+  // the range size is known up front (forward iterators).
+  template <typename InputIt,
+            typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    check_position(pos);
+    size_type index = pos - arr_;
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_type count = std::distance(first, last);
+      if (count == 0) {
+        return arr_ + index;
+      }
+      if (size_ + count > capacity_ || !kNothrowRelocate) {
+        realloc_insert(index, count, [&](iterator dest) {
+          copy_construct(first, last, dest);
+        });
+      } else if (index == size_) {
+        copy_construct(first, last, arr_ + size_);
+        size_ += count;
+      } else {
+        open_gap(index, count);
+        try {
+          copy_construct(first, last, arr_ + index);
+        } catch (...) {
+          close_gap(index, count);
+          throw;
+        }
+        size_ += count;
+      }
+    } else {
+      // Single pass: append, then rotate the new elements into place.
+      size_type old_size = size_;
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+      std::rotate(arr_ + index, arr_ + old_size, arr_ + size_);
     }
+    return arr_ + index;
+  }
 
-    if (pos == end()) {
-      push_back(value);
-      return arr_ + size_ - 1;
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    check_position(pos);
+    size_type index = pos - arr_;
+    if (index == size_) {
+      emplace_back(std::forward<Args>(args)...);
+    } else if (size_ >= capacity_ || !kNothrowRelocate) {
+      realloc_insert(index, 1, [&](iterator dest) {
+        construct(dest, std::forward<Args>(args)...);
+      });
+    } else {
+      // args may refer to an element that is about to be shifted.
+      value_type temp(std::forward<Args>(args)...);
+      move_into_gap(index, std::addressof(temp), 1);
     }
-    size_type newPos = std::distance(begin(), pos);
-    push_back(value);
+    return arr_ + index;
+  }
 
-    value_type temp = arr_[newPos];
-    arr_[newPos] = value;
-    for (size_type i = newPos + 1; i < size() - 1; i++) {
-      std::swap(temp, arr_[i]);
+  // Inserts all args before pos with one reallocation at most and a single
+  // shift of the tail: O(size() + sizeof...(args)).
+  template <typename... Args>
+  iterator insert_many(const_iterator pos, Args &&...args) {
+    check_position(pos);
+    constexpr size_type count = sizeof...(Args);
+    size_type index = pos - arr_;
+    if constexpr (count > 0) {
+      if (size_ + count > capacity_ || !kNothrowRelocate) {
+        realloc_insert(index, count, [&](iterator dest) {
+          construct_each(dest, std::forward<Args>(args)...);
+        });
+      } else if (index == size_) {
+        construct_each(arr_ + size_, std::forward<Args>(args)...);
+        size_ += count;
+      } else {
+        // Built aside first: args may refer to elements that get shifted.
+        alignas(value_type) unsigned char buffer[sizeof(value_type) * count];
+        iterator temp = reinterpret_cast<iterator>(buffer);
+        construct_each(temp, std::forward<Args>(args)...);
+        try {
+          move_into_gap(index, temp, count);
+        } catch (...) {
+          destroy(temp, temp + count);
+          throw;
+        }
+        destroy(temp, temp + count);
+      }
     }
-    arr_[size() - 1] = temp;
-    return arr_ + newPos;
+    return arr_ + index;
+  }
+
+  template <typename... Args>
+  void insert_many_back(Args &&...args) {
+    insert_many(end(), std::forward<Args>(args)...);
+  }
+
+  iterator erase(iterator pos) {
+    check_element(pos);
+    return erase(pos, pos + 1);
   }
 
-  void erase(iterator pos) {
-    if (pos < begin() || pos > end()) {
-      throw std::length_error("Error: invalid area of memory");
+  // Removes [first, last) and shifts the tail down once: O(size()).
+  iterator erase(iterator first, iterator last) {
+    check_range(first, last);
+    size_type count = last - first;
+    if (count > 0) {
+      iterator old_end = end();
+      if constexpr (kTrivialRelocate) {
+        std::memmove(static_cast<void *>(first), last,
+                     (old_end - last) * sizeof(value_type));
+      } else {
+        std::move(last, old_end, first);
+      }
+      destroy(old_end - count, old_end);
+      size_ -= count;
     }
-    for (size_t i = std::distance(begin(), pos); i < size() - 1; i++) {
-      arr_[i] = arr_[i + 1];
+    return first;
+  }
+
+ protected:
+  // True while the elements live in the inline buffer.
+  inline bool is_inline() const {
+    if constexpr (N == 0) {
+      return false;
+    } else {
+      return arr_ == this->inline_data();
     }
-    size_ -= 1;
   }
 
  private:
@@ -214,14 +530,322 @@ class vector {
   size_type size_;
   size_type capacity_;
 
-  void delV() {
-    if (arr_ != nullptr) {
-      delete[] arr_;
-      arr_ = nullptr;
-      size_ = 0;
-      capacity_ = 0;
+  inline void check_index(size_type pos) const {
+    if constexpr (kCheckedMode) {
+      if (pos >= size_) {
+        throw std::out_of_range("Error: invalid index");
+      }
+    }
+  }
+
+  inline void check_position(const_iterator pos) const {
+    if constexpr (kCheckedMode) {
+      if (pos < begin() || pos > end()) {
+        throw std::length_error("Error: invalid area of memory");
+      }
+    }
+  }
+
+  inline void check_element(const_iterator pos) const {
+    if constexpr (kCheckedMode) {
+      if (pos < begin() || pos >= end()) {
+        throw std::length_error("Error: invalid area of memory");
+      }
+    }
+  }
+
+  inline void check_range(const_iterator first, const_iterator last) const {
+    if constexpr (kCheckedMode) {
+      if (first < begin() || last > end() || first > last) {
+        throw std::length_error("Error: invalid area of memory");
+      }
     }
   }
+
+  size_type next_capacity(size_type required) {
+    if (required > max_size()) {
+      throw std::length_error("Error: out of range memory");
+    }
+    size_type grown = this->policy()(capacity_, required);
+    if (grown < required) {
+      grown = required;
+    }
+    return grown > max_size() ? max_size() : grown;
+  }
+
+  // Storage is raw memory: only [arr_, arr_ + size_) holds live objects, the
+  // spare capacity is never constructed.
+  iterator allocate(size_type n) {
+    return alloc_traits::allocate(this->alloc(), n);
+  }
+
+  void deallocate(iterator p, size_type n) {
+    if (p != nullptr) {
+      alloc_traits::deallocate(this->alloc(), p, n);
+    }
+  }
+
+  // Byte copies may replace construction only when the allocator doesn't
+  // customize it.
+  static constexpr bool kTrivialRelocate =
+      std::is_trivially_copyable_v<value_type> &&
+      uses_default_construct<Allocator, value_type>;
+
+  // In-place shifting needs element moves that can't fail halfway.
+  static constexpr bool kNothrowRelocate =
+      std::is_nothrow_move_constructible_v<value_type>;
+
+  static constexpr bool kNothrowMoveAssign =
+      N == 0 && (alloc_traits::propagate_on_container_move_assignment::value ||
+                 alloc_traits::is_always_equal::value);
+
+  template <typename... Args>
+  void construct(iterator p, Args &&...args) {
+    alloc_traits::construct(this->alloc(), p, std::forward<Args>(args)...);
+  }
+
+  void destroy(iterator first, iterator last) {
+    if constexpr (!trivially_destroyed<Allocator, value_type>) {
+      for (; first != last; ++first) {
+        alloc_traits::destroy(this->alloc(), first);
+      }
+    }
+  }
+
+  // Value-initializes n elements at dest.
+  void construct_n(iterator dest, size_type n) {
+    size_type built = 0;
+    try {
+      for (; built < n; built++) {
+        construct(dest + built);
+      }
+    } catch (...) {
+      destroy(dest, dest + built);
+      throw;
+    }
+  }
+
+  template <typename InputIt>
+  void copy_construct(InputIt first, InputIt last, iterator dest) {
+    iterator out = dest;
+    try {
+      for (; first != last; ++first, ++out) {
+        construct(out, *first);
+      }
+    } catch (...) {
+      destroy(dest, out);
+      throw;
+    }
+  }
+
+  // Storage for at least n elements: the inline buffer when it is free and
+  // large enough, the heap otherwise. n is updated to the real capacity.
+  iterator acquire(size_type &n) {
+    if constexpr (N > 0) {
+      if (n <= N && !is_inline()) {
+        n = N;
+        return this->inline_data();
+      }
+    }
+    return allocate(n);
+  }
+
+  void release(iterator p, size_type n) {
+    if (N == 0 || p != this->inline_data()) {
+      deallocate(p, n);
+    }
+  }
+
+  // Takes the elements of v, which is left empty on its inline buffer.
+  // Heap storage changes hands; inline elements have to be moved one by one.
+  void steal(basic_vector &v) {
+    if (v.is_inline()) {
+      relocate(v.arr_, v.arr_ + v.size_, arr_);
+      size_ = v.size_;
+      destroy(v.arr_, v.arr_ + v.size_);
+      v.size_ = 0;
+    } else {
+      arr_ = v.arr_;
+      size_ = v.size_;
+      capacity_ = v.capacity_;
+      v.arr_ = v.inline_data();
+      v.size_ = 0;
+      v.capacity_ = N;
+    }
+  }
+
+  // Moves the elements of v one by one into this empty vector; for
+  // allocators that can't take over v's storage.
+  void move_elements(basic_vector &v) {
+    reserve(v.size_);
+    iterator out = arr_;
+    try {
+      for (iterator it = v.arr_; it != v.arr_ + v.size_; ++it, ++out) {
+        construct(out, std::move(*it));
+      }
+    } catch (...) {
+      destroy(arr_, out);
+      throw;
+    }
+    size_ = v.size_;
+    v.clear();
+  }
+
+  // Exchanges contents with other, whose allocator must be interchangeable
+  // with this one.
+  void swap_storage(basic_vector &other) {
+    if (!is_inline() && !other.is_inline()) {
+      std::swap(arr_, other.arr_);
+      std::swap(size_, other.size_);
+      std::swap(capacity_, other.capacity_);
+    } else {
+      basic_vector temp(this->policy(), this->alloc());
+      temp.steal(other);
+      other.steal(*this);
+      steal(temp);
+    }
+    growth_policy mine(std::move(this->policy()));
+    replace_policy(this->policy(), std::move(other.policy()));
+    replace_policy(other.policy(), std::move(mine));
+  }
+
+  // Constructs [first, last) at dest. memcpy for trivially copyable types,
+  // move when it can't throw, copy otherwise so a throwing copy leaves the
+  // source intact.
+  void relocate(iterator first, iterator last, iterator dest) {
+    if constexpr (kTrivialRelocate) {
+      if (first != last) {
+        std::memcpy(static_cast<void *>(dest), first,
+                    (last - first) * sizeof(value_type));
+      }
+    } else {
+      iterator out = dest;
+      try {
+        for (; first != last; ++first, ++out) {
+          construct(out, std::move_if_noexcept(*first));
+        }
+      } catch (...) {
+        destroy(dest, out);
+        throw;
+      }
+    }
+  }
+
+  void reallocate(size_type new_capacity) {
+    iterator temp = acquire(new_capacity);
+    try {
+      relocate(arr_, arr_ + size_, temp);
+    } catch (...) {
+      release(temp, new_capacity);
+      throw;
+    }
+    destroy(arr_, arr_ + size_);
+    release(arr_, capacity_);
+    arr_ = temp;
+    capacity_ = new_capacity;
+  }
+
+  template <typename... Args>
+  void construct_each(iterator dest, Args &&...args) {
+    size_type built = 0;
+    try {
+      ((construct(dest + built, std::forward<Args>(args)), ++built), ...);
+    } catch (...) {
+      destroy(dest, dest + built);
+      throw;
+    }
+  }
+
+  // Moves the tail [index, size_) up by count slots, leaving
+  // [index, index + count) as raw memory. Capacity must already suffice.
+  void open_gap(size_type index, size_type count) {
+    if constexpr (kTrivialRelocate) {
+      std::memmove(static_cast<void *>(arr_ + index + count), arr_ + index,
+                   (size_ - index) * sizeof(value_type));
+    } else {
+      for (size_type i = size_; i-- > index;) {
+        construct(arr_ + i + count, std::move(arr_[i]));
+        destroy(arr_ + i, arr_ + i + 1);
+      }
+    }
+  }
+
+  // Undoes open_gap.
+  void close_gap(size_type index, size_type count) {
+    if constexpr (kTrivialRelocate) {
+      std::memmove(static_cast<void *>(arr_ + index), arr_ + index + count,
+                   (size_ - index) * sizeof(value_type));
+    } else {
+      for (size_type i = index; i < size_; i++) {
+        construct(arr_ + i, std::move(arr_[i + count]));
+        destroy(arr_ + i + count, arr_ + i + count + 1);
+      }
+    }
+  }
+
+  // Relocates count constructed elements from src into a gap at index.
+  // The source objects stay alive; the caller destroys them.
+  void move_into_gap(size_type index, iterator src, size_type count) {
+    open_gap(index, count);
+    try {
+      relocate(src, src + count, arr_ + index);
+    } catch (...) {
+      close_gap(index, count);
+      throw;
+    }
+    size_ += count;
+  }
+
+  // Builds count new elements at index in a fresh buffer, fill(dest)
+  // constructing them in place, and relocates the old elements around them.
+  // The old buffer is untouched until everything succeeded, so the new
+  // elements may be built from references into this vector.
+  template <typename Fill>
+  void realloc_insert(size_type index, size_type count, Fill fill) {
+    size_type new_capacity =
+        size_ + count > capacity_ ? next_capacity(size_ + count) : capacity_;
+    iterator temp = acquire(new_capacity);
+    try {
+      fill(temp + index);
+    } catch (...) {
+      release(temp, new_capacity);
+      throw;
+    }
+    try {
+      relocate(arr_, arr_ + index, temp);
+    } catch (...) {
+      destroy(temp + index, temp + index + count);
+      release(temp, new_capacity);
+      throw;
+    }
+    try {
+      relocate(arr_ + index, arr_ + size_, temp + index + count);
+    } catch (...) {
+      destroy(temp, temp + index + count);
+      release(temp, new_capacity);
+      throw;
+    }
+    destroy(arr_, arr_ + size_);
+    release(arr_, capacity_);
+    arr_ = temp;
+    capacity_ = new_capacity;
+    size_ += count;
+  }
+
+  void delV() {
+    destroy(arr_, arr_ + size_);
+    release(arr_, capacity_);
+    arr_ = this->inline_data();
+    size_ = 0;
+    capacity_ = N;
+  }
+};
+
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Growth = default_growth>
+class vector : public basic_vector<T, Allocator, Growth, 0> {
+ public:
+  using basic_vector<T, Allocator, Growth, 0>::basic_vector;
 };
 }  // namespace s21
 
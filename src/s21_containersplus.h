@@ -3,5 +3,7 @@
 
 #include "containers/array/s21_array.h"
 #include "containers/multiset/s21_multiset.h"
+#include "containers/small_vector/s21_small_vector.h"
+#include "containers/unrolled_list/s21_unrolled_list.h"
 
 #endif
\ No newline at end of file
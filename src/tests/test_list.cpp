@@ -216,6 +216,497 @@ TEST(S21_List_Test, Unique) {
   EXPECT_EQ(*it1, 3);
 }
 
+TEST(S21_List_Test, Allocator) {
+  alloc_stats first, second;
+  using alloc = counting_allocator<int>;
+  {
+    s21::list<int, alloc> our_list({1, 2, 3}, alloc(&first));
+    EXPECT_EQ(first.live, 1);
+    EXPECT_EQ(first.constructs, 3);
+    our_list.pop_front();
+    s21::list<int, alloc> other({7}, alloc(&second));
+    other = std::move(our_list);
+    EXPECT_TRUE(other.get_allocator() == alloc(&second));
+    EXPECT_EQ(first.live, 1);
+    EXPECT_EQ(second.live, 1);
+    EXPECT_EQ(other.front(), 2);
+    EXPECT_EQ(other.size(), 2U);
+  }
+  EXPECT_EQ(first.live, 0);
+  EXPECT_EQ(second.live, 0);
+}
+
+TEST(S21_List_Test, NodePool_ReserveAndReuse) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::list<int, alloc> our_list{alloc(&stats)};
+    our_list.reserve_nodes(1000);
+    EXPECT_EQ(stats.live, 1);
+    for (int i = 0; i < 1000; i++) {
+      our_list.push_back(i);
+    }
+    for (int round = 0; round < 10; round++) {
+      our_list.pop_front();
+      our_list.push_back(round);
+    }
+    EXPECT_EQ(stats.live, 1);
+    our_list.push_back(1000);
+    EXPECT_EQ(stats.live, 2);
+    EXPECT_EQ(our_list.size(), 1001U);
+    EXPECT_EQ(our_list.front(), 10);
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(S21_List_Test, NodePool_ShrinkToFit) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  s21::list<int, alloc> our_list{alloc(&stats)};
+  for (int i = 0; i < 100; i++) {
+    our_list.push_back(i);
+  }
+  int grown = stats.live;
+  EXPECT_GT(grown, 1);
+  while (our_list.size() > 2) {
+    our_list.pop_back();
+  }
+  our_list.shrink_to_fit();
+  EXPECT_EQ(stats.live, 1);
+  EXPECT_EQ(our_list.front(), 0);
+  EXPECT_EQ(our_list.back(), 1);
+  our_list.clear();
+  our_list.shrink_to_fit();
+  EXPECT_EQ(stats.live, 0);
+  our_list.push_back(5);
+  EXPECT_EQ(our_list.front(), 5);
+}
+
+TEST(S21_List_Test, NodePool_SpliceAdoptsNodes) {
+  s21::list<std::string> our_list = {"a", "b"};
+  {
+    s21::list<std::string> other = {"c", "d", "e"};
+    our_list.splice(our_list.begin(), other);
+    EXPECT_TRUE(other.empty());
+    other.push_back("f");
+  }
+  our_list.pop_front();
+  our_list.push_back("g");
+  s21::list<std::string> expected = {"d", "e", "a", "b", "g"};
+  EXPECT_EQ(our_list.size(), expected.size());
+  for (auto it = our_list.begin(), e = expected.begin(); e != expected.end();
+       ++it, ++e) {
+    EXPECT_EQ(*it, *e);
+  }
+}
+
+TEST(S21_List_Test, SortMatchesStdAndRelinks) {
+  s21::list<int> our_list;
+  std::list<int> std_list;
+  for (int i = 0; i < 1000; i++) {
+    our_list.push_back((i * 7919) % 613);
+    std_list.push_back((i * 7919) % 613);
+  }
+  std::vector<const int *> addresses;
+  for (auto it = our_list.begin(); it != our_list.end(); ++it) {
+    addresses.push_back(&*it);
+  }
+  our_list.sort();
+  std_list.sort();
+  auto std_it = std_list.begin();
+  for (auto it = our_list.begin(); it != our_list.end(); ++it, ++std_it) {
+    EXPECT_EQ(*it, *std_it);
+    EXPECT_NE(std::find(addresses.begin(), addresses.end(), &*it),
+              addresses.end());
+  }
+  EXPECT_EQ(our_list.size(), 1000U);
+  EXPECT_EQ(our_list.back(), 612);
+  auto last = --our_list.end();
+  --last;
+  EXPECT_EQ(*last, 612);
+  our_list.pop_back();
+  EXPECT_EQ(our_list.back(), 612);
+}
+
+TEST(S21_List_Test, SortWithComparatorIsStable) {
+  using item = std::pair<int, char>;
+  s21::list<item> our_list = {{3, 'a'}, {1, 'b'}, {3, 'c'}, {2, 'd'},
+                              {1, 'e'}, {3, 'f'}, {2, 'g'}};
+  our_list.sort(
+      [](const item &a, const item &b) { return a.first > b.first; });
+  std::string order;
+  for (auto it = our_list.begin(); it != our_list.end(); ++it) {
+    order += (*it).second;
+  }
+  EXPECT_EQ(order, "acfdgbe");
+  EXPECT_EQ(our_list.front().second, 'a');
+  EXPECT_EQ(our_list.back().second, 'e');
+  s21::list<item> single = {{1, 'x'}};
+  single.sort();
+  EXPECT_EQ(single.front().second, 'x');
+}
+
+TEST(S21_List_Test, EraseAndInsertAtAnyPosition) {
+  s21::list<int> our_list = {1, 2, 3, 4, 5};
+  auto it = our_list.erase(our_list.begin());
+  EXPECT_EQ(*it, 2);
+  ++it;
+  it = our_list.erase(it);
+  EXPECT_EQ(*it, 4);
+  ++it;
+  EXPECT_TRUE(our_list.erase(it) == our_list.end());
+  EXPECT_EQ(our_list.back(), 4);
+  EXPECT_EQ(our_list.size(), 2U);
+
+  it = our_list.insert(our_list.end(), 6);
+  EXPECT_EQ(*it, 6);
+  EXPECT_EQ(our_list.back(), 6);
+  it = our_list.insert(our_list.begin(), 0);
+  EXPECT_EQ(our_list.front(), 0);
+  ++it;
+  it = our_list.insert(it, 1);
+  --it;
+  EXPECT_EQ(*it, 0);
+  std::vector<int> seen;
+  for (auto i = our_list.begin(); i != our_list.end(); ++i) {
+    seen.push_back(*i);
+  }
+  EXPECT_EQ(seen, std::vector<int>({0, 1, 2, 4, 6}));
+
+  auto first = our_list.begin();
+  ++first;
+  auto last = first;
+  ++last;
+  ++last;
+  it = our_list.erase(first, last);
+  EXPECT_EQ(*it, 4);
+  --it;
+  EXPECT_EQ(*it, 0);
+  EXPECT_EQ(our_list.size(), 3U);
+  EXPECT_TRUE(our_list.erase(our_list.begin(), our_list.end()) ==
+              our_list.end());
+  EXPECT_TRUE(our_list.empty());
+  our_list.insert(our_list.end(), 7);
+  EXPECT_EQ(our_list.front(), 7);
+  EXPECT_EQ(our_list.back(), 7);
+}
+
+template <typename List>
+std::vector<int> contents(List &l) {
+  std::vector<int> result;
+  for (auto it = l.begin(); it != l.end(); ++it) {
+    result.push_back(*it);
+  }
+  std::vector<int> backwards;
+  for (auto it = l.end(); it != l.begin();) {
+    backwards.insert(backwards.begin(), *--it);
+  }
+  EXPECT_EQ(result, backwards);
+  return result;
+}
+
+TEST(S21_List_Test, MergeRelinksOtherNodes) {
+  s21::list<int> our_list = {1, 4, 4, 9};
+  s21::list<int> other = {0, 4, 5, 10, 12};
+  const int *other_four = &*(++other.begin());
+  our_list.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(contents(our_list),
+            std::vector<int>({0, 1, 4, 4, 4, 5, 9, 10, 12}));
+  auto it = our_list.begin();
+  for (int i = 0; i < 4; i++) {
+    ++it;
+  }
+  EXPECT_EQ(&*it, other_four);
+  EXPECT_EQ(our_list.back(), 12);
+  EXPECT_EQ(our_list.size(), 9U);
+  other.push_back(3);
+  our_list.merge(other, std::less<int>());
+  EXPECT_EQ(our_list.size(), 10U);
+  our_list.merge(our_list);
+  EXPECT_EQ(our_list.size(), 10U);
+}
+
+TEST(S21_List_Test, NodePool_RepeatedSpliceAndMergeReuseNodes) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::list<int, alloc> consumer{alloc(&stats)};
+    s21::list<int, alloc> producer{alloc(&stats)};
+    int peak = 0;
+    for (int round = 0; round < 2000; round++) {
+      for (int i = 0; i < 10; i++) {
+        producer.push_back(i);
+      }
+      if (round % 2 == 0) {
+        consumer.splice(consumer.end(), producer);
+      } else {
+        consumer.merge(producer);
+      }
+      for (int i = 0; i < 10; i++) {
+        consumer.pop_front();
+      }
+      if (round == 10) {
+        peak = stats.live;
+      }
+    }
+    EXPECT_TRUE(consumer.empty());
+    EXPECT_LE(stats.live, peak);
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(S21_List_Test, NodePool_SpliceChainsMoveAndSwap) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::list<int, alloc> a({1, 2}, alloc(&stats));
+    s21::list<int, alloc> c({5, 6}, alloc(&stats));
+    {
+      s21::list<int, alloc> b({3, 4}, alloc(&stats));
+      s21::list<int, alloc> d({7, 8}, alloc(&stats));
+      a.splice(a.end(), b);
+      d.splice(d.begin(), c);
+      b.push_back(10);
+      c.push_back(20);
+      a.splice(a.end(), d);
+      s21::list<int, alloc> moved(std::move(b));
+      moved.swap(c);
+      EXPECT_EQ(contents(a), std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+      EXPECT_EQ(contents(c), std::vector<int>({10}));
+      EXPECT_EQ(contents(moved), std::vector<int>({20}));
+      d = std::move(moved);
+      a.splice(a.begin(), d);
+    }
+    EXPECT_EQ(contents(a), std::vector<int>({20, 1, 2, 3, 4, 5, 6, 7, 8}));
+    c.clear();
+    c.shrink_to_fit();
+    for (int i = 0; i < 100; i++) {
+      c.push_back(i);
+    }
+    a.clear();
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(S21_List_Test, MergeAcrossAllocatorsMovesElements) {
+  alloc_stats our_stats;
+  alloc_stats other_stats;
+  using alloc = counting_allocator<int>;
+  s21::list<int, alloc> our_list{alloc(&our_stats)};
+  s21::list<int, alloc> other{alloc(&other_stats)};
+  our_list.push_back(2);
+  other.push_back(1);
+  other.push_back(3);
+  our_list.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(contents(our_list), std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(our_stats.constructs, 3);
+  other.shrink_to_fit();
+  EXPECT_EQ(other_stats.live, 0);
+}
+
+TEST(S21_List_Test, SpliceOverloads) {
+  s21::list<int> our_list = {1, 2, 3};
+  s21::list<int> other = {10, 20, 30, 40};
+  our_list.splice(++our_list.begin(), other, ++other.begin());
+  EXPECT_EQ(contents(our_list), std::vector<int>({1, 20, 2, 3}));
+  EXPECT_EQ(contents(other), std::vector<int>({10, 30, 40}));
+  our_list.splice(our_list.end(), other, other.begin(), other.end());
+  EXPECT_EQ(contents(our_list), std::vector<int>({1, 20, 2, 3, 10, 30, 40}));
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(our_list.size(), 7U);
+
+  auto first = our_list.begin();
+  ++first;
+  auto last = first;
+  ++last;
+  ++last;
+  our_list.splice(our_list.end(), our_list, first, last);
+  EXPECT_EQ(contents(our_list), std::vector<int>({1, 3, 10, 30, 40, 20, 2}));
+  our_list.splice(our_list.begin(), our_list, --our_list.end());
+  EXPECT_EQ(contents(our_list), std::vector<int>({2, 1, 3, 10, 30, 40, 20}));
+  our_list.splice(our_list.begin(), our_list, our_list.begin());
+  EXPECT_EQ(our_list.front(), 2);
+  EXPECT_EQ(our_list.size(), 7U);
+
+  our_list.splice(our_list.end(), other);
+  EXPECT_EQ(our_list.size(), 7U);
+  other.splice(other.end(), our_list);
+  EXPECT_TRUE(our_list.empty());
+  EXPECT_EQ(contents(other), std::vector<int>({2, 1, 3, 10, 30, 40, 20}));
+}
+
+TEST(S21_List_Test, SpliceFromAnotherList) {
+  alloc_stats stats;
+  alloc_stats other_stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::list<int, alloc> our_list({1, 2}, alloc(&stats));
+    s21::list<int, alloc> other({10, 20, 30, 40}, alloc(&stats));
+    our_list.splice(our_list.begin(), other, ++other.begin());
+    auto first = other.begin();
+    ++first;
+    our_list.splice(our_list.end(), other, first, other.end());
+    EXPECT_EQ(contents(our_list), std::vector<int>({20, 1, 2, 30, 40}));
+    EXPECT_EQ(contents(other), std::vector<int>({10}));
+    EXPECT_EQ(our_list.size(), 5U);
+    EXPECT_EQ(other.size(), 1U);
+    for (int i = 0; i < 3; i++) {
+      other.push_back(i);
+      our_list.splice(our_list.end(), other, --other.end());
+    }
+    EXPECT_EQ(other.size(), 1U);
+    EXPECT_EQ(our_list.size(), 8U);
+
+    s21::list<int, alloc> foreign({7, 8}, alloc(&other_stats));
+    our_list.splice(our_list.begin(), foreign, foreign.begin());
+    EXPECT_EQ(our_list.front(), 7);
+    EXPECT_EQ(contents(foreign), std::vector<int>({8}));
+  }
+  EXPECT_EQ(stats.live, 0);
+  EXPECT_EQ(other_stats.live, 0);
+}
+
+TEST(S21_List_Test, SharedPool_SpliceRelinksNodes) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  using list = s21::list<int, alloc>;
+  {
+    list::shared_pool pool{alloc(&stats)};
+    list our_list(pool);
+    list other(pool);
+    for (int i = 1; i <= 6; i++) {
+      other.push_back(i * 10);
+    }
+    our_list.push_back(1);
+    const int constructs = stats.constructs;
+    const int *moved = &*++other.begin();
+    auto last = other.begin();
+    for (int i = 0; i < 4; i++) {
+      ++last;
+    }
+    our_list.splice(our_list.begin(), other, ++other.begin(), last);
+    EXPECT_EQ(&our_list.front(), moved);
+    EXPECT_EQ(contents(our_list), std::vector<int>({20, 30, 40, 1}));
+    EXPECT_EQ(contents(other), std::vector<int>({10, 50, 60}));
+    EXPECT_EQ(our_list.size(), 4U);
+    EXPECT_EQ(other.size(), 3U);
+    our_list.sort();
+    other.merge(our_list);
+    EXPECT_EQ(contents(other), std::vector<int>({1, 10, 20, 30, 40, 50, 60}));
+    our_list.splice(our_list.end(), other);
+    EXPECT_EQ(our_list.size(), 7U);
+    EXPECT_EQ(stats.constructs, constructs);
+    EXPECT_EQ(pool.in_use(), 7U);
+
+    list moved_list(std::move(our_list));
+    list copy(moved_list);
+    copy.splice(copy.begin(), moved_list, moved_list.begin());
+    EXPECT_EQ(copy.size(), 8U);
+    EXPECT_EQ(pool.in_use(), 6U);
+    moved_list.swap(copy);
+    other.splice(other.end(), copy, copy.begin());
+    EXPECT_EQ(pool.in_use(), 6U);
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+// Run under make sanitize_thread: after nodes move from one list to the
+// other, each list is changed from its own thread.
+TEST(S21_List_Test, ListsUsedFromTwoThreadsAfterSplice) {
+  auto churn = [](s21::list<int> &l) {
+    for (int i = 0; i < 20000; i++) {
+      l.push_back(i);
+      if (i % 3 != 0) {
+        l.pop_front();
+      }
+    }
+  };
+  auto run = [&](s21::list<int> &a, s21::list<int> &b) {
+    for (int i = 0; i < 100; i++) {
+      a.push_back(i);
+    }
+    auto last = a.begin();
+    for (int i = 0; i < 50; i++) {
+      ++last;
+    }
+    b.splice(b.end(), a, a.begin(), last);
+    s21::list<int> rest({1, 2, 3});
+    a.splice(a.end(), rest);
+    std::thread first(churn, std::ref(a));
+    std::thread second(churn, std::ref(b));
+    first.join();
+    second.join();
+    EXPECT_EQ(a.size(), 53U + 20000 / 3 + 1);
+    EXPECT_EQ(b.size(), 50U + 20000 / 3 + 1);
+  };
+  {
+    s21::list<int> a;
+    s21::list<int> b;
+    run(a, b);
+  }
+  s21::list<int>::shared_pool pool;
+  {
+    s21::list<int> a(pool);
+    s21::list<int> b(pool);
+    run(a, b);
+  }
+  EXPECT_EQ(pool.in_use(), 0U);
+}
+
+TEST(S21_List_Test, SentinelEnd) {
+  s21::list<int> our_list;
+  auto end = our_list.end();
+  EXPECT_TRUE(our_list.begin() == end);
+  our_list.push_back(2);
+  our_list.push_front(1);
+  our_list.insert(end, 3);
+  EXPECT_TRUE(our_list.end() == end);
+  --end;
+  EXPECT_EQ(*end, 3);
+  --end;
+  EXPECT_EQ(*end, 2);
+  ++end;
+  ++end;
+  EXPECT_TRUE(our_list.end() == end);
+  our_list.erase(--our_list.end());
+  our_list.pop_front();
+  EXPECT_EQ(our_list.front(), 2);
+  EXPECT_EQ(our_list.back(), 2);
+  EXPECT_TRUE(++our_list.begin() == end);
+  our_list.pop_back();
+  EXPECT_TRUE(our_list.begin() == our_list.end());
+  our_list.pop_back();
+  our_list.reverse();
+  our_list.unique();
+  EXPECT_TRUE(our_list.empty());
+}
+
+TEST(S21_List_Test, SentinelSurvivesMoveAndSwap) {
+  s21::list<int> our_list = {1, 2, 3};
+  s21::list<int> moved(std::move(our_list));
+  EXPECT_TRUE(our_list.begin() == our_list.end());
+  our_list.push_back(7);
+  EXPECT_EQ(contents(our_list), std::vector<int>({7}));
+  EXPECT_EQ(contents(moved), std::vector<int>({1, 2, 3}));
+  s21::list<int> empty;
+  moved.swap(empty);
+  EXPECT_TRUE(moved.begin() == moved.end());
+  EXPECT_EQ(contents(empty), std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(*--empty.end(), 3);
+  our_list = std::move(empty);
+  EXPECT_EQ(contents(our_list), std::vector<int>({1, 2, 3}));
+  EXPECT_TRUE(empty.begin() == empty.end());
+  our_list.reverse();
+  EXPECT_EQ(contents(our_list), std::vector<int>({3, 2, 1}));
+  EXPECT_EQ(our_list.front(), 3);
+  our_list.splice(our_list.begin(), moved);
+  s21::list<int> head = {4, 5};
+  our_list.splice(our_list.begin(), head);
+  EXPECT_EQ(contents(our_list), std::vector<int>({4, 5, 3, 2, 1}));
+}
+
 int list(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -242,4 +242,277 @@ TEST(map, MergeMap) {
   EXPECT_EQ(my_map.contains(4), true);
   EXPECT_EQ(my_map_merge.contains(4), false);
   EXPECT_EQ(my_map.contains(5), false);
-}
\ No newline at end of file
+}
+
+TEST(map, AllocatorMap) {
+  alloc_stats stats;
+  using alloc = counting_allocator<std::pair<const int, int>>;
+  {
+    s21::map<int, int, std::less<int>, alloc> my_map{alloc(&stats)};
+    my_map.insert(1, 10);
+    my_map.insert(2, 20);
+    my_map.insert(3, 30);
+    EXPECT_EQ(stats.live, 1);
+    EXPECT_EQ(stats.constructs, 3);
+    s21::map<int, int, std::less<int>, alloc> my_copy(my_map);
+    EXPECT_EQ(stats.live, 2);
+    my_copy.erase(my_copy.find(2));
+    my_copy.insert(4, 40);
+    EXPECT_EQ(stats.live, 2);
+    EXPECT_EQ(my_copy.at(3), 30);
+    EXPECT_EQ(my_copy.at(4), 40);
+    EXPECT_TRUE(my_copy.get_allocator() == alloc(&stats));
+    my_map.clear();
+    EXPECT_EQ(stats.live, 1);
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(map, ArenaCopyIsOneAllocation) {
+  alloc_stats stats;
+  using alloc = counting_allocator<std::pair<const int, std::string>>;
+  s21::map<int, std::string, std::less<int>, alloc> my_map{alloc(&stats)};
+  for (int i = 0; i < 500; i++) {
+    my_map.insert(i, std::string(40, 'a' + i % 26));
+  }
+  int before = stats.live;
+  s21::map<int, std::string, std::less<int>, alloc> my_copy(my_map);
+  EXPECT_EQ(stats.live, before + 1);
+  EXPECT_EQ(my_copy.at(499), std::string(40, 'a' + 499 % 26));
+  my_copy = my_map;
+  EXPECT_EQ(stats.live, before + 1);
+  my_copy.clear();
+  my_map.clear();
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(map, IteratorStability) {
+  s21::map<int, std::string> my_map;
+  std::vector<s21::map<int, std::string>::iterator> its;
+  for (int i = 0; i < 200; i++) {
+    its.push_back(my_map.insert(i, std::to_string(i)).first);
+  }
+  for (int i = 199; i >= 0; i -= 3) {
+    my_map.erase(its[i]);
+  }
+  for (int i = -100; i < 0; i++) {
+    my_map.insert(i, std::to_string(i));
+  }
+  for (int i = 0; i < 200; i++) {
+    if ((199 - i) % 3 != 0) {
+      EXPECT_EQ((*its[i]).first, i);
+      EXPECT_EQ((*its[i]).second, std::to_string(i));
+    }
+  }
+  EXPECT_EQ(my_map.size(), 233U);
+}
+
+
+TEST(map, IteratorReferencesNodeStorage) {
+  s21::map<int, std::string> my_map = {{1, "one"}, {2, "two"}, {3, "three"}};
+  auto it = my_map.find(2);
+  EXPECT_EQ(&*it, &*my_map.find(2));
+  EXPECT_EQ(it->first, 2);
+  EXPECT_EQ(it->second, "two");
+  it->second = "deux";
+  EXPECT_EQ(my_map.at(2), "deux");
+  (*my_map.begin()).second += "!";
+  EXPECT_EQ(my_map.at(1), "one!");
+  s21::map<int, std::string> my_other = {{2, "zwei"}};
+  EXPECT_EQ(my_other.find(2)->second, "zwei");
+  EXPECT_EQ(it->second, "deux");
+  static_assert(
+      std::is_same_v<decltype(*it), std::pair<const int, std::string> &>);
+}
+
+
+TEST(map, AssignInPlace) {
+  alloc_stats stats;
+  using alloc = counting_allocator<std::pair<const int, std::string>>;
+  s21::map<int, std::string, std::less<int>, alloc> my_map{alloc(&stats)};
+  my_map.insert(1, "one");
+  my_map.insert(2, "two");
+  auto it = my_map.find(2);
+  int constructs = stats.constructs;
+
+  auto assigned = my_map.insert_or_assign(2, "deux");
+  EXPECT_TRUE(assigned.first == it);
+  EXPECT_EQ(it->second, "deux");
+  EXPECT_EQ(stats.constructs, constructs);
+
+  std::string value = "zwei";
+  auto emplaced = my_map.try_emplace(2, std::move(value));
+  EXPECT_FALSE(emplaced.second);
+  EXPECT_EQ(value, "zwei");
+  EXPECT_EQ(it->second, "deux");
+  emplaced = my_map.try_emplace(3, 5, 'x');
+  EXPECT_TRUE(emplaced.second);
+  EXPECT_EQ(emplaced.first->second, "xxxxx");
+  EXPECT_EQ(stats.constructs, constructs + 1);
+}
+
+TEST(map, SubscriptCounts) {
+  s21::map<int, int> my_map;
+  for (int i = 0; i < 100; i++) {
+    my_map[i % 7]++;
+  }
+  EXPECT_EQ(my_map.size(), 7U);
+  EXPECT_EQ(my_map[0], 15);
+  EXPECT_EQ(my_map[6], 14);
+  std::map<int, int> orig_map;
+  for (int i = 0; i < 100; i++) {
+    orig_map[i % 7]++;
+  }
+  for (auto &item : orig_map) {
+    EXPECT_EQ(my_map.at(item.first), item.second);
+  }
+}
+
+
+TEST(map, DecrementFromEnd) {
+  s21::map<int, char> my_map = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+  auto it = my_map.end();
+  --it;
+  EXPECT_EQ(it->first, 3);
+  --it;
+  EXPECT_EQ(it->second, 'b');
+  EXPECT_TRUE(my_map.find(5) == my_map.end());
+  my_map.erase(my_map.find(3));
+  EXPECT_EQ((--my_map.end())->first, 2);
+}
+
+
+TEST(map, BuildFromRange) {
+  std::map<int, std::string> orig_map;
+  for (int i = 0; i < 300; i++) {
+    orig_map[i * 3] = std::to_string(i);
+  }
+  s21::map<int, std::string> my_map(orig_map.begin(), orig_map.end());
+  EXPECT_EQ(my_map.size(), orig_map.size());
+  auto orig_it = orig_map.begin();
+  for (auto it = my_map.begin(); it != my_map.end(); ++it, ++orig_it) {
+    EXPECT_EQ(it->first, orig_it->first);
+    EXPECT_EQ(it->second, orig_it->second);
+  }
+  std::vector<std::pair<int, std::string>> items = {
+      {2, "b"}, {1, "a"}, {2, "x"}, {3, "c"}};
+  my_map.assign(items.begin(), items.end());
+  EXPECT_EQ(my_map.size(), 3U);
+  EXPECT_EQ(my_map.at(2), "b");
+  EXPECT_EQ(my_map.begin()->second, "a");
+  my_map[0] = "zero";
+  EXPECT_EQ(my_map.begin()->second, "zero");
+}
+
+
+TEST(map, MergeAndSetAlgebraKeepFirstValues) {
+  s21::map<int, std::string> my_map = {{1, "a"}, {2, "b"}, {3, "c"}};
+  s21::map<int, std::string> my_other = {{2, "x"}, {4, "y"}};
+  auto kept = my_map.find(2);
+  auto moved = my_other.find(4);
+  my_map.merge(my_other);
+  EXPECT_EQ(my_map.size(), 4U);
+  EXPECT_EQ(kept->second, "b");
+  EXPECT_EQ(moved->second, "y");
+  EXPECT_TRUE(my_map.find(4) == moved);
+
+  s21::map<int, std::string> first = {{1, "a"}, {2, "b"}};
+  s21::map<int, std::string> second = {{2, "x"}, {3, "y"}};
+  auto both = s21::set_union(first, second);
+  EXPECT_EQ(both.size(), 3U);
+  EXPECT_EQ(both.at(2), "b");
+  EXPECT_EQ(both.at(3), "y");
+  auto common = s21::set_intersection(second, first);
+  EXPECT_EQ(common.size(), 1U);
+  EXPECT_EQ(common.at(2), "x");
+  auto only_first = s21::set_difference(first, second);
+  EXPECT_EQ(only_first.size(), 1U);
+  EXPECT_EQ(only_first.at(1), "a");
+}
+
+TEST(map, NthAndRank) {
+  s21::map<int, std::string> scores = {
+      {40, "dana"}, {10, "ari"}, {30, "cy"}, {20, "bo"}};
+  EXPECT_EQ(scores.nth(0)->second, "ari");
+  EXPECT_EQ(scores.nth(3)->second, "dana");
+  EXPECT_TRUE(scores.nth(4) == scores.end());
+  EXPECT_EQ(scores.rank(30), 2U);
+  EXPECT_EQ(scores.rank(25), 2U);
+  EXPECT_EQ(scores.rank(99), 4U);
+  scores.erase(scores.find(20));
+  scores[5] = "eve";
+  EXPECT_EQ(scores.nth(1)->second, "ari");
+  EXPECT_EQ(scores.rank(30), 2U);
+  EXPECT_TRUE(scores.nth(scores.rank(40)) == scores.find(40));
+}
+
+TEST(map, TimeWindow) {
+  s21::map<long, int> events;
+  for (long t = 0; t < 1000; t += 10) {
+    events[t] = static_cast<int>(t / 10);
+  }
+  int sum = 0;
+  int count = 0;
+  for (auto &event : events.range(95, 150)) {
+    sum += event.second;
+    event.second = 0;
+    count++;
+  }
+  EXPECT_EQ(count, 5);
+  EXPECT_EQ(sum, 10 + 11 + 12 + 13 + 14);
+  EXPECT_EQ(events.at(100), 0);
+  EXPECT_EQ(events.at(90), 9);
+  EXPECT_EQ(events.lower_bound(95)->first, 100);
+  EXPECT_EQ(events.upper_bound(100)->first, 110);
+  auto hit = events.equal_range(100);
+  EXPECT_EQ(hit.first->first, 100);
+  EXPECT_EQ(hit.second->first, 110);
+  auto miss = events.equal_range(105);
+  EXPECT_TRUE(miss.first == miss.second);
+  EXPECT_TRUE(events.lower_bound(991) == events.end());
+}
+
+TEST(map, TransparentLookup) {
+  using alloc = counting_allocator<std::pair<const std::string, int>>;
+  alloc_stats stats;
+  s21::map<std::string, int, std::less<>, alloc> prices{std::less<>(),
+                                                        alloc(&stats)};
+  prices["apple"] = 3;
+  prices["banana"] = 1;
+  prices["cherry"] = 7;
+  int constructs = stats.constructs;
+  std::string_view key = "banana";
+  auto it = prices.find(key);
+  ASSERT_TRUE(it != prices.end());
+  EXPECT_EQ(it->second, 1);
+  EXPECT_TRUE(prices.contains(std::string_view("cherry")));
+  EXPECT_TRUE(prices.find(std::string_view("durian")) == prices.end());
+  EXPECT_EQ(prices.lower_bound(std::string_view("b"))->first, "banana");
+  EXPECT_EQ(prices.upper_bound(key)->first, "cherry");
+  auto hit = prices.equal_range(key);
+  EXPECT_EQ(hit.first->first, "banana");
+  EXPECT_EQ(hit.second->first, "cherry");
+  EXPECT_EQ(stats.constructs, constructs);
+}
+
+TEST(map, CustomComparator) {
+  struct case_insensitive {
+    bool operator()(const std::string &a, const std::string &b) const {
+      return std::lexicographical_compare(
+          a.begin(), a.end(), b.begin(), b.end(), [](char x, char y) {
+            return std::tolower(static_cast<unsigned char>(x)) <
+                   std::tolower(static_cast<unsigned char>(y));
+          });
+    }
+  };
+  s21::map<std::string, int, case_insensitive> counts;
+  counts["Apple"]++;
+  counts["APPLE"]++;
+  counts["banana"]++;
+  EXPECT_EQ(counts.size(), 2U);
+  EXPECT_EQ(counts.begin()->first, "Apple");
+  EXPECT_EQ(counts.at("apple"), 2);
+  EXPECT_FALSE(counts.insert("BANANA", 5).second);
+  s21::map<std::string, int, case_insensitive> copy = counts;
+  EXPECT_TRUE(copy.contains("aPpLe"));
+}
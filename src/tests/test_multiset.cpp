@@ -228,4 +228,59 @@ TEST(multiset, Upper_Bound) {
   EXPECT_TRUE(*orig_it == *my_it);
 }
 
+TEST(multiset, Allocator) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::multiset<int, std::less<int>, alloc> my_set{alloc(&stats)};
+    my_set.insert(3);
+    my_set.insert(5);
+    my_set.insert(3);
+    EXPECT_EQ(stats.live, 1);
+    EXPECT_EQ(stats.constructs, 3);
+    EXPECT_EQ(my_set.count(3), 2U);
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(multiset, CustomComparator) {
+  using pair = std::pair<int, char>;
+  struct by_first {
+    bool operator()(const pair &a, const pair &b) const {
+      return a.first > b.first;
+    }
+  };
+  s21::multiset<pair, by_first> my_set;
+  auto first = my_set.insert({2, 'a'});
+  my_set.insert({5, 'b'});
+  auto second = my_set.insert({2, 'c'});
+  EXPECT_EQ((*first).second, 'a');
+  EXPECT_EQ((*second).second, 'c');
+  s21::multiset<pair, by_first> other;
+  other.insert({2, 'd'});
+  other.insert({1, 'e'});
+  my_set.merge(other);
+  EXPECT_TRUE(other.empty());
+  std::string order;
+  for (const auto &item : my_set) {
+    order += item.second;
+  }
+  EXPECT_EQ(order, "bacde");
+  EXPECT_EQ(my_set.count({2, 'z'}), 3U);
+  EXPECT_EQ((*my_set.find({2, 'z'})).second, 'a');
+  EXPECT_TRUE(my_set.find({3, 'z'}) == my_set.end());
+  EXPECT_EQ((*my_set.upper_bound({2, 'z'})).second, 'e');
+}
+
+TEST(multiset, TransparentLookup) {
+  s21::multiset<std::string, std::less<>> words = {"pear", "fig", "pear",
+                                                  "apple"};
+  std::string_view key = "pear";
+  EXPECT_EQ(words.count(key), 2U);
+  EXPECT_TRUE(words.contains(std::string_view("fig")));
+  EXPECT_EQ(*words.lower_bound(std::string_view("b")), "fig");
+  auto range = words.equal_range(key);
+  EXPECT_TRUE(range.second == words.end());
+}
+
 }  // namespace
\ No newline at end of file
@@ -104,4 +104,13 @@ TEST(Queue, Modifier_Swap) {
   }
 }
 
+TEST(Queue, ListWithAllocator) {
+  s21::queue<int, s21::list<int, std::allocator<int>>> s21_queue = {1, 2, 3};
+  s21_queue.push(4);
+  s21_queue.pop();
+  EXPECT_EQ(s21_queue.front(), 2);
+  EXPECT_EQ(s21_queue.back(), 4);
+  EXPECT_EQ(s21_queue.size(), 3U);
+}
+
 }  // namespace
\ No newline at end of file
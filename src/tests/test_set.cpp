@@ -174,4 +174,441 @@ TEST(set, ContainsSet) {
   EXPECT_EQ(empty, false);
 }
 
+TEST(set, AllocatorSet) {
+  alloc_stats first, second;
+  using alloc = counting_allocator<int, true>;
+  {
+    s21::set<int, std::less<int>, alloc> my_set{alloc(&first)};
+    my_set.insert(5);
+    my_set.insert(1);
+    s21::set<int, std::less<int>, alloc> other{alloc(&second)};
+    other.insert(7);
+    other = my_set;
+    EXPECT_TRUE(other.get_allocator() == alloc(&first));
+    EXPECT_EQ(first.live, 2);
+    EXPECT_EQ(second.live, 0);
+    EXPECT_TRUE(other.contains(5));
+    EXPECT_FALSE(other.contains(7));
+  }
+  EXPECT_EQ(first.live, 0);
+}
+
+TEST(set, SizeTracking) {
+  s21::set<int> my_set = {5, 3, 8, 1, 4};
+  EXPECT_EQ(my_set.size(), 5U);
+  my_set.insert(3);
+  EXPECT_EQ(my_set.size(), 5U);
+  my_set.erase(my_set.find(5));
+  my_set.erase(my_set.find(1));
+  EXPECT_EQ(my_set.size(), 3U);
+  s21::set<int> my_copy(my_set);
+  EXPECT_EQ(my_copy.size(), 3U);
+  s21::set<int> my_other = {10, 11};
+  my_other.swap(my_copy);
+  EXPECT_EQ(my_other.size(), 3U);
+  EXPECT_EQ(my_copy.size(), 2U);
+  my_other.merge(my_copy);
+  EXPECT_EQ(my_other.size(), 5U);
+  EXPECT_EQ(my_copy.size(), 0U);
+  s21::set<int> my_moved(std::move(my_other));
+  EXPECT_EQ(my_moved.size(), 5U);
+  EXPECT_EQ(my_other.size(), 0U);
+  my_set = my_moved;
+  EXPECT_EQ(my_set.size(), 5U);
+  my_set.clear();
+  EXPECT_EQ(my_set.size(), 0U);
+  EXPECT_TRUE(my_set.empty());
+}
+
+TEST(set, IteratorStability) {
+  s21::set<int> my_set;
+  std::vector<s21::set<int>::iterator> its;
+  for (int i = 0; i < 200; i++) {
+    its.push_back(my_set.insert(i).first);
+  }
+  for (int i = 0; i < 200; i += 2) {
+    my_set.erase(its[i]);
+  }
+  for (int i = 200; i < 400; i++) {
+    my_set.insert(i);
+  }
+  for (int i = 1; i < 200; i += 2) {
+    EXPECT_EQ(*its[i], i);
+  }
+  EXPECT_EQ(my_set.size(), 300U);
+  int prev = -1;
+  for (auto it = my_set.begin(); it != my_set.end(); ++it) {
+    EXPECT_LT(prev, *it);
+    prev = *it;
+  }
+}
+
+TEST(set, InsertReturnsNode) {
+  s21::set<int> my_set = {5, 3, 8};
+  auto inserted = my_set.insert(4);
+  EXPECT_TRUE(inserted.second);
+  EXPECT_EQ(*inserted.first, 4);
+  auto existing = my_set.insert(8);
+  EXPECT_FALSE(existing.second);
+  EXPECT_EQ(*existing.first, 8);
+  EXPECT_EQ(my_set.size(), 4U);
+}
+
+TEST(set, MatchesStdSetUnderChurn) {
+  s21::set<int> my_set;
+  std::set<int> std_set;
+  unsigned state = 12345;
+  for (int i = 0; i < 20000; i++) {
+    state = state * 1103515245 + 12345;
+    int key = static_cast<int>((state >> 8) % 2000);
+    if (state & 1) {
+      EXPECT_EQ(my_set.insert(key).second, std_set.insert(key).second);
+    } else if (my_set.contains(key)) {
+      my_set.erase(my_set.find(key));
+      std_set.erase(key);
+    }
+  }
+  ASSERT_EQ(my_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto it = my_set.begin(); it != my_set.end(); ++it, ++std_it) {
+    EXPECT_EQ(*it, *std_it);
+  }
+}
+
+// Reads the root height, which set keeps protected.
+struct height_probe : s21::set<int> {
+  int height() const { return root() == nullptr ? 0 : root()->n_height; }
+};
+
+TEST(set, HeightStaysLogarithmic) {
+  height_probe my_set;
+  for (int i = 0; i < 1023; i++) {
+    my_set.insert(i);
+  }
+  // A perfectly balanced tree of 1023 nodes has height 10; AVL allows at
+  // most about 1.44 * log2(n).
+  EXPECT_LE(my_set.height(), 14);
+  EXPECT_GE(my_set.height(), 10);
+  for (int i = 0; i < 1023; i += 2) {
+    my_set.erase(my_set.find(i));
+  }
+  EXPECT_LE(my_set.height(), 13);
+}
+
+TEST(set, IterateBothWays) {
+  s21::set<int> my_set;
+  EXPECT_TRUE(my_set.begin() == my_set.end());
+  std::set<int> orig_set;
+  for (int i = 0; i < 100; i++) {
+    my_set.insert((i * 37) % 101);
+    orig_set.insert((i * 37) % 101);
+  }
+  EXPECT_TRUE(my_set.find(1000) == my_set.end());
+  auto my_it = my_set.end();
+  for (auto orig_it = orig_set.rbegin(); orig_it != orig_set.rend();
+       ++orig_it) {
+    --my_it;
+    EXPECT_EQ(*my_it, *orig_it);
+  }
+  EXPECT_TRUE(my_it == my_set.begin());
+  ++my_it;
+  EXPECT_EQ(*my_it, *std::next(orig_set.begin()));
+}
+
+TEST(set, IterateAfterSwapAndMove) {
+  s21::set<int> my_set = {1, 2, 3};
+  s21::set<int> my_other = {7, 8};
+  my_set.swap(my_other);
+  EXPECT_EQ(*--my_set.end(), 8);
+  EXPECT_EQ(*--my_other.end(), 3);
+  int count = 0;
+  for (auto it = my_other.begin(); it != my_other.end(); ++it) {
+    count++;
+  }
+  EXPECT_EQ(count, 3);
+  s21::set<int> my_moved(std::move(my_other));
+  EXPECT_TRUE(my_other.begin() == my_other.end());
+  EXPECT_EQ(*--my_moved.end(), 3);
+  my_other = std::move(my_moved);
+  EXPECT_EQ(*my_other.begin(), 1);
+  EXPECT_EQ(*--my_other.end(), 3);
+}
+
+TEST(set, BuildFromSortedRange) {
+  std::vector<int> keys;
+  for (int i = 0; i < 1023; i++) {
+    keys.push_back(i * 2);
+  }
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  s21::set<int, std::less<int>, alloc> my_set(keys.begin(), keys.end(),
+                                              alloc(&stats));
+  EXPECT_EQ(stats.live, 1);
+  EXPECT_EQ(stats.constructs, 1023);
+  EXPECT_EQ(my_set.size(), 1023U);
+  auto key = keys.begin();
+  for (auto it = my_set.begin(); it != my_set.end(); ++it, ++key) {
+    EXPECT_EQ(*it, *key);
+  }
+  height_probe probe;
+  probe.assign(keys.begin(), keys.end());
+  EXPECT_EQ(probe.height(), 10);
+  probe.insert(1);
+  probe.erase(probe.find(0));
+  EXPECT_TRUE(probe.contains(1));
+  EXPECT_EQ(*probe.begin(), 1);
+}
+
+TEST(set, BuildFromUnsortedRange) {
+  std::vector<int> keys = {5, 1, 3, 1, 5, 2};
+  s21::set<int> my_set(keys.begin(), keys.end());
+  std::set<int> orig_set(keys.begin(), keys.end());
+  EXPECT_EQ(my_set.size(), orig_set.size());
+  auto orig_it = orig_set.begin();
+  for (auto it = my_set.begin(); it != my_set.end(); ++it, ++orig_it) {
+    EXPECT_EQ(*it, *orig_it);
+  }
+  std::istringstream input("9 7 9 8");
+  my_set.assign(std::istream_iterator<int>(input),
+                std::istream_iterator<int>());
+  EXPECT_EQ(my_set.size(), 3U);
+  EXPECT_EQ(*my_set.begin(), 7);
+  EXPECT_FALSE(my_set.contains(5));
+}
+
+TEST(set, MergeStealsNodes) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  for (int other_size : {3, 300}) {
+    s21::set<int, std::less<int>, alloc> my_set{alloc(&stats)};
+    s21::set<int, std::less<int>, alloc> my_other{alloc(&stats)};
+    std::set<int> orig_set;
+    for (int i = 0; i < 1000; i += 2) {
+      my_set.insert(i);
+      orig_set.insert(i);
+    }
+    for (int i = 0; i < other_size; i++) {
+      my_other.insert(i * 3);
+      orig_set.insert(i * 3);
+    }
+    int constructs = stats.constructs;
+    my_set.merge(my_other);
+    EXPECT_EQ(stats.constructs, constructs);
+    EXPECT_EQ(my_other.size(), 0U);
+    EXPECT_TRUE(my_other.begin() == my_other.end());
+    ASSERT_EQ(my_set.size(), orig_set.size());
+    auto orig_it = orig_set.begin();
+    for (auto it = my_set.begin(); it != my_set.end(); ++it, ++orig_it) {
+      EXPECT_EQ(*it, *orig_it);
+    }
+    my_other.insert(7);
+    my_set.insert(1001);
+    EXPECT_TRUE(my_set.contains(1001));
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(set, RepeatedMergeReusesNodes) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::set<int, std::less<int>, alloc> my_set{alloc(&stats)};
+    s21::set<int, std::less<int>, alloc> my_other{alloc(&stats)};
+    int peak = 0;
+    for (int round = 0; round < 2000; round++) {
+      for (int i = 0; i < 10; i++) {
+        my_other.insert(round * 10 + i);
+      }
+      my_set.merge(my_other);
+      for (int i = 0; i < 10; i++) {
+        my_set.erase(my_set.find(round * 10 + i));
+      }
+      if (round == 10) {
+        peak = stats.live;
+      }
+    }
+    EXPECT_TRUE(my_set.empty());
+    EXPECT_LE(stats.live, peak);
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(set, SetAlgebra) {
+  for (int b_size : {2, 50, 400}) {
+    s21::set<int> a;
+    s21::set<int> b;
+    std::set<int> orig_a;
+    std::set<int> orig_b;
+    for (int i = 0; i < 400; i++) {
+      a.insert(i * 3);
+      orig_a.insert(i * 3);
+    }
+    for (int i = 0; i < b_size; i++) {
+      b.insert(i * 5);
+      orig_b.insert(i * 5);
+    }
+    std::vector<int> expected;
+    auto check = [&](s21::set<int> result) {
+      ASSERT_EQ(result.size(), expected.size());
+      auto it = result.begin();
+      for (int key : expected) {
+        EXPECT_EQ(*it, key);
+        ++it;
+      }
+      expected.clear();
+    };
+    std::set_union(orig_a.begin(), orig_a.end(), orig_b.begin(), orig_b.end(),
+                   std::back_inserter(expected));
+    check(s21::set_union(a, b));
+    std::set_intersection(orig_a.begin(), orig_a.end(), orig_b.begin(),
+                          orig_b.end(), std::back_inserter(expected));
+    check(s21::set_intersection(a, b));
+    std::set_intersection(orig_b.begin(), orig_b.end(), orig_a.begin(),
+                          orig_a.end(), std::back_inserter(expected));
+    check(s21::set_intersection(b, a));
+    std::set_difference(orig_a.begin(), orig_a.end(), orig_b.begin(),
+                        orig_b.end(), std::back_inserter(expected));
+    check(s21::set_difference(a, b));
+    std::set_difference(orig_b.begin(), orig_b.end(), orig_a.begin(),
+                        orig_a.end(), std::back_inserter(expected));
+    check(s21::set_difference(b, a));
+  }
+}
+
+// Checks nth() and rank() at every position against a sorted reference.
+void expect_order_statistics(s21::set<int> &my_set,
+                             const std::set<int> &std_set) {
+  ASSERT_EQ(my_set.size(), std_set.size());
+  std::size_t k = 0;
+  for (int key : std_set) {
+    EXPECT_EQ(*my_set.nth(k), key);
+    EXPECT_EQ(my_set.rank(key), k);
+    EXPECT_EQ(my_set.rank(key + 1), k + 1);
+    k++;
+  }
+  EXPECT_TRUE(my_set.nth(k) == my_set.end());
+}
+
+TEST(set, OrderStatistics) {
+  s21::set<int> my_set;
+  std::set<int> std_set;
+  EXPECT_TRUE(my_set.nth(0) == my_set.end());
+  EXPECT_EQ(my_set.rank(5), 0U);
+  unsigned state = 777;
+  for (int i = 0; i < 20000; i++) {
+    state = state * 1103515245 + 12345;
+    int key = static_cast<int>((state >> 8) % 1000) * 2;
+    if (state & 1) {
+      my_set.insert(key);
+      std_set.insert(key);
+    } else if (my_set.contains(key)) {
+      my_set.erase(my_set.find(key));
+      std_set.erase(key);
+    }
+  }
+  expect_order_statistics(my_set, std_set);
+
+  s21::set<int> my_copy(my_set);
+  expect_order_statistics(my_copy, std_set);
+  s21::set<int> my_other;
+  std::set<int> std_other;
+  for (int i = 1; i < 4000; i += 3) {
+    my_other.insert(i);
+    std_other.insert(i);
+  }
+  my_copy.merge(my_other);
+  std::set<int> std_merged = std_set;
+  std_merged.insert(std_other.begin(), std_other.end());
+  expect_order_statistics(my_copy, std_merged);
+  s21::set<int> my_small = {-3, 5, 4001};
+  my_copy.merge(my_small);
+  std_merged.insert({-3, 5, 4001});
+  expect_order_statistics(my_copy, std_merged);
+
+  std::vector<int> items(std_other.begin(), std_other.end());
+  s21::set<int> my_built(items.begin(), items.end());
+  expect_order_statistics(my_built, std_other);
+  std::set<int> std_difference;
+  std::set_difference(std_merged.begin(), std_merged.end(), std_set.begin(),
+                      std_set.end(),
+                      std::inserter(std_difference, std_difference.end()));
+  my_built = s21::set_difference(my_copy, my_set);
+  expect_order_statistics(my_built, std_difference);
+}
+
+TEST(set, BoundsMatchStdSet) {
+  s21::set<int> my_set;
+  std::set<int> std_set;
+  EXPECT_TRUE(my_set.lower_bound(1) == my_set.end());
+  EXPECT_TRUE(my_set.upper_bound(1) == my_set.end());
+  for (int i = 0; i < 500; i++) {
+    int key = (i * 37) % 1000;
+    my_set.insert(key);
+    std_set.insert(key);
+  }
+  for (int key = -2; key < 1002; key++) {
+    auto lower = my_set.lower_bound(key);
+    auto upper = my_set.upper_bound(key);
+    auto std_lower = std_set.lower_bound(key);
+    auto std_upper = std_set.upper_bound(key);
+    if (std_lower == std_set.end()) {
+      EXPECT_TRUE(lower == my_set.end());
+    } else {
+      EXPECT_EQ(*lower, *std_lower);
+    }
+    if (std_upper == std_set.end()) {
+      EXPECT_TRUE(upper == my_set.end());
+    } else {
+      EXPECT_EQ(*upper, *std_upper);
+    }
+    auto equal = my_set.equal_range(key);
+    EXPECT_TRUE(equal.first == lower);
+    EXPECT_TRUE(equal.second == upper);
+  }
+}
+
+TEST(set, RangeView) {
+  s21::set<int> my_set = {1, 3, 5, 7, 9};
+  std::vector<int> seen;
+  for (int key : my_set.range(3, 8)) {
+    seen.push_back(key);
+  }
+  EXPECT_EQ(seen, std::vector<int>({3, 5, 7}));
+  EXPECT_TRUE(my_set.range(4, 5).empty());
+  EXPECT_TRUE(my_set.range(8, 3).empty());
+  EXPECT_TRUE(my_set.range(9, 100).begin() == my_set.find(9));
+  EXPECT_TRUE(my_set.range(9, 100).end() == my_set.end());
+  EXPECT_FALSE(my_set.range(0, 2).empty());
+}
+
+TEST(set, CustomComparator) {
+  using desc_set = s21::set<int, std::greater<int>>;
+  desc_set my_set = {4, 1, 9, 7};
+  std::set<int, std::greater<int>> std_set = {4, 1, 9, 7};
+  auto std_it = std_set.begin();
+  for (int key : my_set) {
+    EXPECT_EQ(key, *std_it++);
+  }
+  EXPECT_EQ(*my_set.lower_bound(5), 4);
+  EXPECT_EQ(*my_set.upper_bound(7), 4);
+  EXPECT_TRUE(my_set.contains(9));
+  EXPECT_FALSE(my_set.insert(7).second);
+  desc_set other = {3, 7, 10};
+  desc_set both = s21::set_union(my_set, other);
+  std::vector<int> merged;
+  for (int key : both) {
+    merged.push_back(key);
+  }
+  EXPECT_EQ(merged, std::vector<int>({10, 9, 7, 4, 3, 1}));
+  my_set.merge(other);
+  EXPECT_EQ(*my_set.begin(), 10);
+  EXPECT_EQ(my_set.size(), 6U);
+  EXPECT_TRUE(other.empty());
+  std::vector<int> window;
+  for (int key : my_set.range(9, 3)) {
+    window.push_back(key);
+  }
+  EXPECT_EQ(window, std::vector<int>({9, 7, 4}));
+}
+
 }  // namespace
\ No newline at end of file
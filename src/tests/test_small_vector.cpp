@@ -0,0 +1,102 @@
+#include "tests.h"
+
+namespace {
+TEST(SmallVector, Constructor_Default) {
+  s21::small_vector<int, 8> s21_vector;
+  EXPECT_TRUE(s21_vector.empty());
+  EXPECT_EQ(s21_vector.capacity(), size_t(8));
+  EXPECT_TRUE(s21_vector.is_small());
+}
+
+TEST(SmallVector, Constructor_Initializer) {
+  s21::small_vector<int, 4> small = {1, 2, 3};
+  s21::small_vector<int, 4> large = {1, 2, 3, 4, 5, 6};
+  EXPECT_TRUE(small.is_small());
+  EXPECT_FALSE(large.is_small());
+  EXPECT_EQ(small.back(), 3);
+  EXPECT_EQ(large.back(), 6);
+  EXPECT_EQ(large.size(), size_t(6));
+}
+
+TEST(SmallVector, Modifier_SpillToHeap) {
+  s21::small_vector<std::string, 4> s21_vector;
+  std::vector<std::string> std_vector;
+  for (int i = 0; i < 4; i++) {
+    s21_vector.push_back(std::string(20, 'a' + i));
+    std_vector.push_back(std::string(20, 'a' + i));
+  }
+  EXPECT_TRUE(s21_vector.is_small());
+  EXPECT_EQ(s21_vector.capacity(), size_t(4));
+  s21_vector.push_back(s21_vector[0]);
+  std_vector.push_back(std_vector[0]);
+  EXPECT_FALSE(s21_vector.is_small());
+  s21_vector.insert_many(s21_vector.begin() + 1, "x", "y");
+  std_vector.insert(std_vector.begin() + 1, {"x", "y"});
+  ASSERT_EQ(s21_vector.size(), std_vector.size());
+  for (size_t i = 0; i < std_vector.size(); i++) {
+    EXPECT_EQ(s21_vector[i], std_vector[i]);
+  }
+  s21_vector.erase(s21_vector.begin(), s21_vector.begin() + 4);
+  s21_vector.reduce();
+  EXPECT_TRUE(s21_vector.is_small());
+  EXPECT_EQ(s21_vector.front(), std_vector[4]);
+  EXPECT_EQ(s21_vector.back(), std_vector[6]);
+}
+
+TEST(SmallVector, Constructor_CopyMove) {
+  s21::small_vector<std::string, 2> small = {"a", "b"};
+  s21::small_vector<std::string, 2> large = {"c", "d", "e"};
+
+  s21::small_vector<std::string, 2> small_copy = small;
+  s21::small_vector<std::string, 2> large_copy = large;
+  EXPECT_EQ(small_copy[1], "b");
+  EXPECT_EQ(large_copy[2], "e");
+
+  s21::small_vector<std::string, 2> small_moved = std::move(small);
+  s21::small_vector<std::string, 2> large_moved = std::move(large);
+  EXPECT_TRUE(small.empty());
+  EXPECT_TRUE(large.empty());
+  EXPECT_TRUE(small.is_small());
+  EXPECT_TRUE(large.is_small());
+  EXPECT_EQ(small_moved[0], "a");
+  EXPECT_EQ(large_moved[0], "c");
+
+  small_moved = large_copy;
+  EXPECT_EQ(small_moved.size(), size_t(3));
+  large_moved = std::move(small_copy);
+  EXPECT_EQ(large_moved.size(), size_t(2));
+  EXPECT_TRUE(large_moved.is_small());
+}
+
+TEST(SmallVector, Modifier_Swap) {
+  s21::small_vector<int, 3> small = {1, 2};
+  s21::small_vector<int, 3> large = {5, 6, 7, 8};
+  small.swap(large);
+  EXPECT_EQ(small.size(), size_t(4));
+  EXPECT_EQ(large.size(), size_t(2));
+  EXPECT_EQ(small[3], 8);
+  EXPECT_EQ(large[1], 2);
+  EXPECT_TRUE(large.is_small());
+
+  s21::small_vector<int, 3> other_large = {9, 9, 9, 9, 9};
+  small.swap(other_large);
+  EXPECT_EQ(small.size(), size_t(5));
+  EXPECT_EQ(other_large[0], 5);
+}
+
+TEST(SmallVector, Allocator) {
+  alloc_stats stats;
+  using alloc = counting_allocator<int>;
+  {
+    s21::small_vector<int, 2, alloc> s21_vector{alloc(&stats)};
+    s21_vector.push_back(1);
+    s21_vector.push_back(2);
+    EXPECT_EQ(stats.live, 0);
+    s21_vector.push_back(3);
+    EXPECT_EQ(stats.live, 1);
+    EXPECT_FALSE(s21_vector.is_small());
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+}  // namespace
@@ -101,4 +101,18 @@ TEST(Stack, Modifier_Swap) {
   }
 }
 
-}  // namespace
\ No newline at end of file
+TEST(Stack, SmallVectorContainer) {
+  s21::stack<int, s21::small_vector<int, 16>> s21_stack;
+  std::stack<int> std_stack;
+  for (int i = 0; i < 20; i++) {
+    s21_stack.push(i);
+    std_stack.push(i);
+  }
+  while (!std_stack.empty()) {
+    EXPECT_EQ(s21_stack.top(), std_stack.top());
+    s21_stack.pop(), std_stack.pop();
+  }
+  EXPECT_TRUE(s21_stack.empty());
+}
+
+}  // namespace
@@ -0,0 +1,191 @@
+#include "tests.h"
+
+namespace {
+template <typename List>
+std::vector<std::string> contents(const List &l) {
+  std::vector<std::string> result;
+  for (auto it = l.begin(); it != l.end(); ++it) {
+    result.push_back(*it);
+  }
+  return result;
+}
+
+template <typename List>
+void expect_same(const List &l, const std::list<std::string> &expected) {
+  ASSERT_EQ(l.size(), expected.size());
+  EXPECT_EQ(contents(l),
+            std::vector<std::string>(expected.begin(), expected.end()));
+  std::vector<std::string> backwards;
+  for (auto it = l.end(); it != l.begin();) {
+    backwards.insert(backwards.begin(), *--it);
+  }
+  EXPECT_EQ(backwards, contents(l));
+}
+
+TEST(UnrolledList, Constructor_Default) {
+  s21::unrolled_list<int> l;
+  EXPECT_TRUE(l.empty());
+  EXPECT_EQ(l.size(), 0U);
+  EXPECT_TRUE(l.begin() == l.end());
+  EXPECT_EQ(l.chunk_count(), 0U);
+}
+
+TEST(UnrolledList, PushPopBothEnds) {
+  s21::unrolled_list<std::string, 4> l;
+  std::list<std::string> expected;
+  for (int i = 0; i < 20; i++) {
+    l.push_back("b" + std::to_string(i));
+    expected.push_back("b" + std::to_string(i));
+    l.push_front("f" + std::to_string(i));
+    expected.push_front("f" + std::to_string(i));
+  }
+  expect_same(l, expected);
+  EXPECT_EQ(l.front(), "f19");
+  EXPECT_EQ(l.back(), "b19");
+  EXPECT_LE(l.chunk_count(), l.size() / 4 + 1);
+  for (int i = 0; i < 15; i++) {
+    l.pop_back();
+    expected.pop_back();
+    l.pop_front();
+    expected.pop_front();
+  }
+  expect_same(l, expected);
+  while (!l.empty()) {
+    l.pop_front();
+  }
+  l.pop_back();
+  EXPECT_EQ(l.chunk_count(), 0U);
+}
+
+TEST(UnrolledList, InsertAndEraseWhileIterating) {
+  s21::unrolled_list<std::string, 4> l;
+  std::list<std::string> expected;
+  for (int i = 0; i < 40; i++) {
+    l.push_back(std::to_string(i));
+    expected.push_back(std::to_string(i));
+  }
+  auto it = l.begin();
+  auto std_it = expected.begin();
+  for (int i = 0; it != l.end(); i++) {
+    if (i % 3 == 0) {
+      it = l.insert(it, "x" + *it);
+      std_it = expected.insert(std_it, "x" + *std_it);
+      EXPECT_EQ(*it, *std_it);
+      ++it;
+      ++std_it;
+    } else if (i % 3 == 1) {
+      it = l.erase(it);
+      std_it = expected.erase(std_it);
+      continue;
+    }
+    ++it;
+    ++std_it;
+  }
+  expect_same(l, expected);
+  EXPECT_LE(l.chunk_count(), l.size() / 2 + 1);
+
+  auto first = l.begin();
+  auto std_first = expected.begin();
+  for (int i = 0; i < 5; i++) {
+    ++first;
+    ++std_first;
+  }
+  auto last = first;
+  auto std_last = std_first;
+  for (int i = 0; i < 17; i++) {
+    ++last;
+    ++std_last;
+  }
+  it = l.erase(first, last);
+  std_it = expected.erase(std_first, std_last);
+  EXPECT_EQ(*it, *std_it);
+  expect_same(l, expected);
+  EXPECT_TRUE(l.erase(l.begin(), l.end()) == l.end());
+  EXPECT_TRUE(l.empty());
+}
+
+TEST(UnrolledList, InsertAliasesElement) {
+  s21::unrolled_list<std::string, 4> l = {"a", "b", "c"};
+  auto it = l.begin();
+  ++it;
+  l.insert(it, *l.begin());
+  l.insert(l.begin(), l.back());
+  expect_same(l, {"c", "a", "a", "b", "c"});
+}
+
+TEST(UnrolledList, InsertAliasesElementOfSplitChunk) {
+  const std::string a(40, 'a'), b(40, 'b'), c(40, 'c'), d(40, 'd');
+  s21::unrolled_list<std::string, 4> l = {a, b, c, d};
+  ASSERT_EQ(l.chunk_count(), 1U);
+  auto last = l.end();
+  --last;
+  l.insert(++l.begin(), *last);
+  expect_same(l, {a, d, b, c, d});
+}
+
+TEST(UnrolledList, CopyMoveSwap) {
+  s21::unrolled_list<std::string, 4> l = {"1", "2", "3", "4", "5", "6"};
+  s21::unrolled_list<std::string, 4> copy(l);
+  expect_same(copy, {"1", "2", "3", "4", "5", "6"});
+  s21::unrolled_list<std::string, 4> moved(std::move(l));
+  EXPECT_TRUE(l.empty());
+  l.push_back("7");
+  expect_same(l, {"7"});
+  expect_same(moved, {"1", "2", "3", "4", "5", "6"});
+  s21::unrolled_list<std::string, 4> empty;
+  moved.swap(empty);
+  EXPECT_TRUE(moved.begin() == moved.end());
+  expect_same(empty, {"1", "2", "3", "4", "5", "6"});
+  copy = l;
+  expect_same(copy, {"7"});
+  copy = std::move(empty);
+  expect_same(copy, {"1", "2", "3", "4", "5", "6"});
+  EXPECT_TRUE(empty.empty());
+}
+
+TEST(UnrolledList, SpliceRelinksChunks) {
+  s21::unrolled_list<std::string, 4> l = {"a", "b", "c", "d", "e", "f"};
+  s21::unrolled_list<std::string, 4> other = {"1", "2", "3", "4", "5"};
+  const std::string *moved = &other.back();
+  auto pos = l.begin();
+  ++pos;
+  ++pos;
+  l.splice(pos, other);
+  EXPECT_TRUE(other.empty());
+  expect_same(l, {"a", "b", "1", "2", "3", "4", "5", "c", "d", "e", "f"});
+  auto it = l.begin();
+  for (int i = 0; i < 6; i++) {
+    ++it;
+  }
+  EXPECT_EQ(&*it, moved);
+  other.push_back("z");
+  l.splice(l.end(), other);
+  l.splice(l.begin(), other);
+  EXPECT_EQ(l.back(), "z");
+  EXPECT_EQ(l.size(), 12U);
+}
+
+TEST(UnrolledList, Allocator) {
+  alloc_stats ours;
+  alloc_stats theirs;
+  using alloc = counting_allocator<int>;
+  {
+    s21::unrolled_list<int, 8, alloc> l{alloc(&ours)};
+    for (int i = 0; i < 20; i++) {
+      l.push_back(i);
+    }
+    EXPECT_EQ(ours.constructs, 20);
+    EXPECT_EQ(ours.live, 1);
+    s21::unrolled_list<int, 8, alloc> other{alloc(&theirs)};
+    other.push_back(-1);
+    other.push_back(-2);
+    l.splice(l.begin(), other);
+    EXPECT_TRUE(other.empty());
+    EXPECT_EQ(l.front(), -1);
+    EXPECT_EQ(l.size(), 22U);
+    EXPECT_EQ(ours.constructs, 22);
+  }
+  EXPECT_EQ(ours.live, 0);
+  EXPECT_EQ(theirs.live, 0);
+}
+}  // namespace
@@ -151,4 +151,441 @@ TEST(Vector, Throw) {
   EXPECT_THROW(v.back(), std::logic_error);
 }
 
-}  // namespace
\ No newline at end of file
+template <typename Growth>
+using growth_vector = s21::vector<int, std::allocator<int>, Growth>;
+
+TEST(Vector, Growth_Geometric) {
+  s21::vector<int> s21_vector;
+  size_t reallocations = 0;
+  size_t capacity = s21_vector.capacity();
+  for (int i = 0; i < 1000; i++) {
+    s21_vector.push_back(i);
+    if (s21_vector.capacity() != capacity) {
+      EXPECT_GE(s21_vector.capacity(), 2 * capacity);
+      capacity = s21_vector.capacity();
+      reallocations++;
+    }
+  }
+  EXPECT_EQ(s21_vector.size(), size_t(1000));
+  EXPECT_LE(reallocations, size_t(11));
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(s21_vector[i], i);
+  }
+}
+
+TEST(Vector, Growth_OneAndHalf) {
+  growth_vector<s21::geometric_growth<3, 2>> s21_vector;
+  s21_vector.push_back(1);
+  EXPECT_EQ(s21_vector.capacity(), size_t(1));
+  s21_vector.push_back(2);
+  EXPECT_EQ(s21_vector.capacity(), size_t(2));
+  s21_vector.push_back(3);
+  EXPECT_EQ(s21_vector.capacity(), size_t(3));
+  s21_vector.push_back(4);
+  EXPECT_EQ(s21_vector.capacity(), size_t(4));
+  s21_vector.push_back(5);
+  EXPECT_EQ(s21_vector.capacity(), size_t(6));
+}
+
+TEST(Vector, Growth_Fixed) {
+  growth_vector<s21::fixed_growth<8>> s21_vector;
+  for (int i = 0; i < 20; i++) {
+    s21_vector.push_back(i);
+  }
+  EXPECT_EQ(s21_vector.capacity(), size_t(24));
+  EXPECT_EQ(s21_vector.back(), 19);
+}
+
+TEST(Vector, Growth_Callable) {
+  auto quadruple = [](size_t capacity, size_t required) {
+    return capacity == 0 ? required : capacity * 4;
+  };
+  growth_vector<decltype(quadruple)> s21_vector(quadruple);
+  for (int i = 0; i < 5; i++) {
+    s21_vector.push_back(i);
+  }
+  EXPECT_EQ(s21_vector.capacity(), size_t(16));
+
+  auto lazy = [](size_t, size_t) { return size_t(0); };
+  growth_vector<decltype(lazy)> s21_vector_2(lazy);
+  s21_vector_2.push_back(1);
+  s21_vector_2.push_back(2);
+  EXPECT_EQ(s21_vector_2.capacity(), size_t(2));
+
+  growth_vector<decltype(quadruple)> sized(3, quadruple);
+  EXPECT_EQ(sized.size(), size_t(3));
+  sized.push_back(3);
+  EXPECT_EQ(sized.capacity(), size_t(12));
+  growth_vector<decltype(quadruple)> listed({1, 2}, quadruple);
+  listed.push_back(3);
+  EXPECT_EQ(listed.capacity(), size_t(8));
+
+  growth_vector<decltype(quadruple)> copy(s21_vector);
+  copy = listed;
+  EXPECT_EQ(copy.size(), size_t(3));
+  copy = std::move(sized);
+  EXPECT_EQ(copy.size(), size_t(4));
+  copy.swap(listed);
+  EXPECT_EQ(copy.size(), size_t(3));
+  EXPECT_EQ(listed.size(), size_t(4));
+  growth_vector<decltype(quadruple)> moved(std::move(copy));
+  EXPECT_EQ(moved.capacity(), size_t(8));
+  while (moved.size() < 9) {
+    moved.push_back(0);
+  }
+  EXPECT_EQ(moved.capacity(), size_t(32));
+}
+
+TEST(Vector, Growth_CapturingCallable) {
+  auto scaled = [](size_t factor) {
+    return [factor](size_t capacity, size_t required) {
+      return std::max(capacity * factor, required);
+    };
+  };
+  using policy = decltype(scaled(0));
+  static_assert(!std::is_copy_assignable_v<policy>);
+  growth_vector<policy> triple({1, 2}, scaled(3));
+  growth_vector<policy> fivefold({1, 2}, scaled(5));
+  triple = fivefold;
+  triple.push_back(3);
+  EXPECT_EQ(triple.capacity(), size_t(10));
+  growth_vector<policy> doubled({1}, scaled(2));
+  doubled.swap(fivefold);
+  fivefold.push_back(2);
+  EXPECT_EQ(fivefold.capacity(), size_t(2));
+  doubled.push_back(3);
+  EXPECT_EQ(doubled.capacity(), size_t(10));
+}
+
+TEST(Vector, Growth_NoSpaceForEmptyPolicy) {
+  static_assert(sizeof(s21::vector<int>) == 3 * sizeof(void *));
+  static_assert(sizeof(growth_vector<s21::fixed_growth<8>>) ==
+                3 * sizeof(void *));
+  s21::vector<int> s21_vector = {1, 2, 3};
+  EXPECT_EQ(s21_vector.size(), size_t(3));
+}
+
+TEST(Vector, Growth_Function) {
+  using policy = std::function<size_t(size_t, size_t)>;
+  policy triple = [](size_t capacity, size_t required) {
+    return std::max(capacity * 3, required);
+  };
+  growth_vector<policy> sized(2, triple);
+  sized.push_back(1);
+  EXPECT_EQ(sized.capacity(), size_t(6));
+  growth_vector<policy> listed({1, 2, 3}, triple);
+  listed.push_back(4);
+  EXPECT_EQ(listed.capacity(), size_t(9));
+  growth_vector<policy> assigned(triple);
+  assigned = listed;
+  assigned.swap(sized);
+  assigned.push_back(5);
+  EXPECT_EQ(assigned.size(), size_t(4));
+}
+
+struct Tracked {
+  static inline int constructed = 0;
+  static inline int copied = 0;
+  static inline int moved = 0;
+  static inline int alive = 0;
+
+  static void reset() { constructed = copied = moved = alive = 0; }
+
+  Tracked() : value(0) { constructed++, alive++; }
+  Tracked(int v) : value(v) { constructed++, alive++; }
+  Tracked(const Tracked &other) : value(other.value) { copied++, alive++; }
+  Tracked(Tracked &&other) noexcept : value(other.value) { moved++, alive++; }
+  Tracked &operator=(const Tracked &other) = default;
+  ~Tracked() { alive--; }
+
+  int value;
+};
+
+TEST(Vector, Storage_ReserveConstructsNothing) {
+  Tracked::reset();
+  {
+    s21::vector<Tracked> s21_vector;
+    s21_vector.reserve(100);
+    EXPECT_EQ(Tracked::constructed, 0);
+    EXPECT_EQ(Tracked::alive, 0);
+    s21_vector.push_back(Tracked(1));
+    EXPECT_EQ(Tracked::alive, 1);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(Vector, Storage_ReallocationMoves) {
+  Tracked::reset();
+  {
+    s21::vector<Tracked> s21_vector;
+    for (int i = 0; i < 100; i++) {
+      s21_vector.push_back(i);
+    }
+    EXPECT_EQ(Tracked::copied, 0);
+    EXPECT_GT(Tracked::moved, 0);
+    EXPECT_EQ(Tracked::alive, 100);
+    for (int i = 0; i < 100; i++) {
+      EXPECT_EQ(s21_vector[i].value, i);
+    }
+    s21_vector.pop_back();
+    s21_vector.erase(s21_vector.begin());
+    EXPECT_EQ(Tracked::alive, 98);
+    s21_vector.clear();
+    EXPECT_EQ(Tracked::alive, 0);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(Vector, Storage_Strings) {
+  s21::vector<std::string> s21_vector;
+  std::vector<std::string> std_vector;
+  for (int i = 0; i < 50; i++) {
+    std::string value(20 + i, 'a' + i % 26);
+    s21_vector.push_back(value);
+    std_vector.push_back(value);
+  }
+  s21_vector.push_back(s21_vector[0]);
+  std_vector.push_back(std_vector[0]);
+  s21::vector<std::string> s21_copy = s21_vector;
+  s21_vector.reasize(10);
+  s21_vector.reduce();
+  EXPECT_EQ(s21_vector.capacity(), size_t(10));
+  EXPECT_EQ(s21_copy.size(), std_vector.size());
+  for (size_t i = 0; i < std_vector.size(); i++) {
+    EXPECT_EQ(s21_copy[i], std_vector[i]);
+  }
+  s21_copy.reasize(60);
+  EXPECT_EQ(s21_copy.size(), size_t(60));
+  EXPECT_TRUE(s21_copy[59].empty());
+}
+
+TEST(Vector, Modifier_Emplace) {
+  s21::vector<std::pair<int, std::string>> s21_vector;
+  std::vector<std::pair<int, std::string>> std_vector;
+  s21_vector.emplace_back(1, "one");
+  std_vector.emplace_back(1, "one");
+  s21_vector.emplace_back(3, "three");
+  std_vector.emplace_back(3, "three");
+  auto it = s21_vector.emplace(s21_vector.begin() + 1, 2, "two");
+  std_vector.emplace(std_vector.begin() + 1, 2, "two");
+  EXPECT_EQ(it->second, "two");
+  s21_vector.emplace(s21_vector.begin(), 0, "zero");
+  std_vector.emplace(std_vector.begin(), 0, "zero");
+  ASSERT_EQ(s21_vector.size(), std_vector.size());
+  for (size_t i = 0; i < std_vector.size(); i++) {
+    EXPECT_EQ(s21_vector[i], std_vector[i]);
+  }
+}
+
+TEST(Vector, Modifier_PushMoveOnly) {
+  s21::vector<std::unique_ptr<int>> s21_vector;
+  for (int i = 0; i < 10; i++) {
+    s21_vector.push_back(std::make_unique<int>(i));
+  }
+  s21_vector.insert(s21_vector.begin(), std::make_unique<int>(-1));
+  EXPECT_EQ(*s21_vector.front(), -1);
+  EXPECT_EQ(*s21_vector.back(), 9);
+  EXPECT_EQ(*s21_vector[5], 4);
+}
+
+TEST(Vector, Modifier_InsertAliasing) {
+  s21::vector<std::string> s21_vector = {"a", "b", "c"};
+  std::vector<std::string> std_vector = {"a", "b", "c"};
+  s21_vector.reserve(10);
+  s21_vector.insert(s21_vector.begin(), s21_vector[2]);
+  std_vector.insert(std_vector.begin(), std_vector[2]);
+  s21_vector.reduce();
+  s21_vector.insert(s21_vector.begin() + 1, s21_vector[3]);
+  std_vector.insert(std_vector.begin() + 1, std_vector[3]);
+  s21_vector.insert_many(s21_vector.begin(), s21_vector[4], s21_vector[0]);
+  std_vector.insert(std_vector.begin(), {std_vector[4], std_vector[0]});
+  ASSERT_EQ(s21_vector.size(), std_vector.size());
+  for (size_t i = 0; i < std_vector.size(); i++) {
+    EXPECT_EQ(s21_vector[i], std_vector[i]);
+  }
+}
+
+TEST(Vector, Modifier_InsertMany) {
+  s21::vector<int> s21_vector = {1, 2, 6};
+  auto it = s21_vector.insert_many(s21_vector.begin() + 2, 3, 4, 5);
+  EXPECT_EQ(*it, 3);
+  s21_vector.insert_many_back(7, 8);
+  s21_vector.insert_many(s21_vector.begin());
+  s21_vector.reserve(20);
+  s21_vector.insert_many(s21_vector.begin(), -1, 0);
+  s21::vector<int> expected = {-1, 0, 1, 2, 3, 4, 5, 6, 7, 8};
+  ASSERT_EQ(s21_vector.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(s21_vector[i], expected[i]);
+  }
+}
+
+TEST(Vector, Modifier_InsertManyStrings) {
+  s21::vector<std::string> s21_vector = {"a", "e"};
+  s21_vector.insert_many(s21_vector.begin() + 1, "b", std::string("c"), "d");
+  s21_vector.reserve(10);
+  s21_vector.insert_many(s21_vector.begin(), "x", "y");
+  s21_vector.insert_many_back("f");
+  std::vector<std::string> expected = {"x", "y", "a", "b", "c", "d", "e", "f"};
+  ASSERT_EQ(s21_vector.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(s21_vector[i], expected[i]);
+  }
+}
+
+TEST(Vector, Element_ConstAccess) {
+  const s21::vector<int> s21_vector = {1, 2, 3, 4};
+  int sum = 0;
+  for (size_t i = 0; i < s21_vector.size(); i++) {
+    sum += s21_vector[i];
+  }
+  for (auto it = s21_vector.cbegin(); it != s21_vector.cend(); ++it) {
+    sum += *it;
+  }
+  EXPECT_EQ(sum, 20);
+  EXPECT_EQ(s21_vector.at(3), 4);
+  EXPECT_EQ(*s21_vector.data(), 1);
+  EXPECT_THROW(s21_vector.at(4), std::out_of_range);
+}
+
+TEST(Vector, Element_CheckedMode) {
+  s21::vector<int> s21_vector = {1, 2, 3};
+  if (s21::kCheckedMode) {
+    EXPECT_THROW(s21_vector[3], std::out_of_range);
+    EXPECT_THROW(s21_vector.insert(s21_vector.end() + 1, 1),
+                 std::length_error);
+    EXPECT_THROW(s21_vector.insert_many(s21_vector.begin() - 1, 1, 2),
+                 std::length_error);
+    EXPECT_THROW(s21_vector.erase(s21_vector.end()), std::length_error);
+  } else {
+    EXPECT_EQ(&s21_vector[2], s21_vector.end() - 1);
+  }
+  EXPECT_THROW(s21_vector.at(3), std::out_of_range);
+}
+
+TEST(Vector, Modifier_EraseRange) {
+  s21::vector<int> s21_vector = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<int> std_vector = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  auto it = s21_vector.erase(s21_vector.begin() + 2, s21_vector.begin() + 5);
+  std_vector.erase(std_vector.begin() + 2, std_vector.begin() + 5);
+  EXPECT_EQ(*it, 5);
+  it = s21_vector.erase(s21_vector.begin() + 1, s21_vector.begin() + 1);
+  EXPECT_EQ(*it, 1);
+  ASSERT_EQ(s21_vector.size(), std_vector.size());
+  for (size_t i = 0; i < std_vector.size(); i++) {
+    EXPECT_EQ(s21_vector[i], std_vector[i]);
+  }
+  s21_vector.erase(s21_vector.begin(), s21_vector.end());
+  EXPECT_TRUE(s21_vector.empty());
+}
+
+TEST(Vector, Modifier_EraseRangeStrings) {
+  Tracked::reset();
+  {
+    s21::vector<Tracked> s21_vector;
+    for (int i = 0; i < 10; i++) {
+      s21_vector.emplace_back(i);
+    }
+    s21_vector.erase(s21_vector.begin() + 1, s21_vector.begin() + 8);
+    EXPECT_EQ(Tracked::alive, 3);
+    EXPECT_EQ(s21_vector[1].value, 8);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+
+  s21::vector<std::string> s21_vector = {"a", "b", "c", "d", "e"};
+  s21_vector.erase(s21_vector.begin(), s21_vector.begin() + 2);
+  ASSERT_EQ(s21_vector.size(), size_t(3));
+  EXPECT_EQ(s21_vector[0], "c");
+  EXPECT_EQ(s21_vector[2], "e");
+}
+
+TEST(Vector, Modifier_InsertRange) {
+  std::vector<std::string> source = {"x", "y", "z"};
+  s21::vector<std::string> s21_vector = {"a", "b"};
+  std::vector<std::string> std_vector = {"a", "b"};
+  auto it = s21_vector.insert(s21_vector.begin() + 1, source.begin(),
+                              source.end());
+  std_vector.insert(std_vector.begin() + 1, source.begin(), source.end());
+  EXPECT_EQ(*it, "x");
+  s21_vector.reserve(20);
+  s21_vector.insert(s21_vector.begin(), source.begin(), source.end());
+  std_vector.insert(std_vector.begin(), source.begin(), source.end());
+  std::list<std::string> list_source = {"l", "m"};
+  s21_vector.insert(s21_vector.end(), list_source.begin(), list_source.end());
+  std_vector.insert(std_vector.end(), list_source.begin(), list_source.end());
+  s21_vector.insert(s21_vector.begin(), source.end(), source.end());
+  ASSERT_EQ(s21_vector.size(), std_vector.size());
+  for (size_t i = 0; i < std_vector.size(); i++) {
+    EXPECT_EQ(s21_vector[i], std_vector[i]);
+  }
+}
+
+TEST(Vector, Modifier_InsertInputRange) {
+  std::istringstream input("3 4 5");
+  s21::vector<int> s21_vector = {1, 2, 6};
+  s21_vector.insert(s21_vector.begin() + 2, std::istream_iterator<int>(input),
+                    std::istream_iterator<int>());
+  s21::vector<int> expected = {1, 2, 3, 4, 5, 6};
+  ASSERT_EQ(s21_vector.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(s21_vector[i], expected[i]);
+  }
+}
+
+TEST(Vector, Allocator_UsedForStorageAndElements) {
+  alloc_stats stats;
+  {
+    using alloc = counting_allocator<std::string>;
+    s21::vector<std::string, alloc> s21_vector{
+        alloc(&stats)};
+    for (int i = 0; i < 10; i++) {
+      s21_vector.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(stats.live, 1);
+    EXPECT_GE(stats.constructs, 10);
+    EXPECT_TRUE(s21_vector.get_allocator() == alloc(&stats));
+    EXPECT_EQ(s21_vector[9], "9");
+  }
+  EXPECT_EQ(stats.live, 0);
+}
+
+TEST(Vector, Allocator_Propagation) {
+  alloc_stats first, second;
+  using alloc = counting_allocator<int>;
+  using vec = s21::vector<int, alloc>;
+  {
+    vec a({1, 2, 3}, alloc(&first));
+    vec b({4, 5}, alloc(&second));
+    b = std::move(a);
+    EXPECT_TRUE(b.get_allocator() == alloc(&second));
+    EXPECT_EQ(b.size(), 3U);
+    EXPECT_EQ(b[2], 3);
+    EXPECT_EQ(first.live, 1);
+    EXPECT_EQ(second.live, 1);
+    vec c(b);
+    EXPECT_TRUE(c.get_allocator() == alloc(&second));
+    EXPECT_EQ(second.live, 2);
+  }
+  EXPECT_EQ(first.live, 0);
+  EXPECT_EQ(second.live, 0);
+
+  using prop_alloc = counting_allocator<int, true>;
+  using prop_vec = s21::vector<int, prop_alloc>;
+  {
+    prop_vec a({1, 2, 3}, prop_alloc(&first));
+    prop_vec b({4, 5}, prop_alloc(&second));
+    b = a;
+    EXPECT_TRUE(b.get_allocator() == prop_alloc(&first));
+    EXPECT_EQ(second.live, 0);
+    prop_vec c({6}, prop_alloc(&second));
+    c.swap(b);
+    EXPECT_TRUE(c.get_allocator() == prop_alloc(&first));
+    EXPECT_TRUE(b.get_allocator() == prop_alloc(&second));
+    EXPECT_EQ(c[2], 3);
+    EXPECT_EQ(b[0], 6);
+  }
+  EXPECT_EQ(first.live, 0);
+  EXPECT_EQ(second.live, 0);
+}
+
+}  // namespace
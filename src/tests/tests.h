@@ -4,16 +4,75 @@
 #include <gtest/gtest.h>
 #include <string.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdio>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
+#include <set>
+#include <sstream>
 #include <stack>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "../s21_containers.h"
 #include "../s21_containersplus.h"
 
+// Stateful allocator for the allocator tests. Copies share the counters of
+// the instance they came from and compare equal only to each other; the
+// Propagate flag switches all three propagation traits.
+struct alloc_stats {
+  int live = 0;
+  int constructs = 0;
+};
+
+template <typename T, bool Propagate = false>
+struct counting_allocator {
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+  using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+  using propagate_on_container_swap = std::bool_constant<Propagate>;
+
+  template <typename U>
+  struct rebind {
+    using other = counting_allocator<U, Propagate>;
+  };
+
+  explicit counting_allocator(alloc_stats *s) : stats(s) {}
+  template <typename U>
+  counting_allocator(const counting_allocator<U, Propagate> &other)
+      : stats(other.stats) {}
+
+  T *allocate(size_t n) {
+    stats->live++;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T *p, size_t n) {
+    stats->live--;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U, typename... Args>
+  void construct(U *p, Args &&...args) {
+    stats->constructs++;
+    ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+
+  template <typename U>
+  bool operator==(const counting_allocator<U, Propagate> &other) const {
+    return stats == other.stats;
+  }
+  template <typename U>
+  bool operator!=(const counting_allocator<U, Propagate> &other) const {
+    return stats != other.stats;
+  }
+
+  alloc_stats *stats;
+};
+
 #endif
\ No newline at end of file